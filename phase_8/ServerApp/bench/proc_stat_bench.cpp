@@ -0,0 +1,112 @@
+// proc_stat_bench.cpp
+// Compares the old ifstream/getline/istringstream /proc/stat parsing with
+// ProcFile (persistent fd + pread) and parseProcStat on captured fixtures.
+//
+//   proc_stat_bench [fixture_dir] [iterations]
+#include "../proc_reader.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef PROC_FIXTURE_DIR
+#define PROC_FIXTURE_DIR "ServerApp/bench/fixtures"
+#endif
+
+// the parser TelemetrySampler used before ProcFile
+static bool legacyReadCpuTimes(const std::string &path, std::vector<CpuTimes> &times) {
+    times.clear();
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("cpu", 0) != 0) {
+            continue;
+        }
+        if (line.size() > 3 && std::isdigit(static_cast<unsigned char>(line[3]))) {
+            std::istringstream iss(line);
+            std::string label;
+            CpuTimes ct;
+            iss >> label
+                >> ct.user
+                >> ct.nice
+                >> ct.system
+                >> ct.idle
+                >> ct.iowait
+                >> ct.irq
+                >> ct.softirq
+                >> ct.steal;
+            times.push_back(ct);
+        }
+    }
+
+    return !times.empty();
+}
+
+static bool sameTimes(const std::vector<CpuTimes> &a, const std::vector<CpuTimes> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].user != b[i].user || a[i].nice != b[i].nice || a[i].system != b[i].system ||
+            a[i].idle != b[i].idle || a[i].iowait != b[i].iowait || a[i].irq != b[i].irq ||
+            a[i].softirq != b[i].softirq || a[i].steal != b[i].steal) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Fn>
+static double nsPerCall(int iterations, Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    const std::string dir = (argc > 1) ? argv[1] : PROC_FIXTURE_DIR;
+    const int iterations = (argc > 2) ? std::stoi(argv[2]) : 20000;
+
+    std::cout << "cores   legacy ns/read   pread+scan ns/read   speedup\n";
+
+    int failures = 0;
+    for (int cores : {4, 64, 256}) {
+        const std::string path = dir + "/proc_stat_" + std::to_string(cores) + ".txt";
+
+        std::vector<CpuTimes> legacy;
+        std::vector<CpuTimes> scanned;
+        ProcFile file(path);
+        std::string_view text;
+        if (!legacyReadCpuTimes(path, legacy) || !file.read(text) || !parseProcStat(text, scanned)) {
+            std::cerr << "cannot read fixture " << path << "\n";
+            ++failures;
+            continue;
+        }
+        if (!sameTimes(legacy, scanned) || scanned.size() != static_cast<size_t>(cores)) {
+            std::cerr << "parsers disagree on " << path << "\n";
+            ++failures;
+            continue;
+        }
+
+        double legacyNs = nsPerCall(iterations, [&] { legacyReadCpuTimes(path, legacy); });
+        double scanNs = nsPerCall(iterations, [&] {
+            file.read(text);
+            parseProcStat(text, scanned);
+        });
+
+        std::cout << cores << "\t" << legacyNs << "\t\t" << scanNs << "\t\t\t" << legacyNs / scanNs << "x\n";
+    }
+
+    return failures == 0 ? 0 : 1;
+}
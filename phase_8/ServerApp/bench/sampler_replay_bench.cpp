@@ -0,0 +1,48 @@
+// sampler_replay_bench.cpp
+// Measures the cost of one TelemetrySampler tick by replaying a recording made
+// with telemetry_record. Replayed files are served from memory, so the number
+// is parsing + delta computation + snapshot publication, without syscalls.
+//
+//   sampler_replay_bench <recording_dir> [ticks]
+#include "../telemetry_sampler.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: sampler_replay_bench <recording_dir> [ticks]\n";
+        return 1;
+    }
+    const std::string dir = argv[1];
+    const int ticks = (argc > 2) ? std::stoi(argv[2]) : 100000;
+
+    TelemetrySampler sampler(std::chrono::milliseconds(1), "/", dir);
+    if (!sampler.isReplaying()) {
+        return 1;
+    }
+
+    // a listener the size of the server's, so the snapshot is really consumed
+    size_t cores = 0;
+    sampler.setListener([&](const TelemetrySnapshotPlain &snapshot) {
+        cores += snapshot.cores.size();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    int failed = 0;
+    for (int i = 0; i < ticks; ++i) {
+        if (!sampler.sampleOnce()) {
+            ++failed;
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    TelemetrySnapshotPlain last;
+    sampler.latest(last);
+    std::cout << "ticks " << ticks << ", " << elapsed.count() / ticks << " ns/tick, "
+              << cores / static_cast<size_t>(ticks) << " cores, last temp " << last.temperatureC
+              << " C, ram " << last.ramUsagePercent << " %\n";
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// thermal_sensors_check.cpp
+// Runs ThermalSensors discovery against the fake sysfs tree in
+// fixtures/sysfs and checks the sensors found, their order, their CPU and
+// duplicate classification and one reading.
+// Exits non-zero on the first mismatch.
+//
+//   thermal_sensors_check [fixture_sysfs_root]
+#include "../thermal_sensors.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef THERMAL_FIXTURE_DIR
+#define THERMAL_FIXTURE_DIR "ServerApp/bench/fixtures/sysfs"
+#endif
+
+struct Expected {
+    const char *label;
+    const char *type;
+    float celsius;
+    bool cpu;
+    bool duplicate;
+};
+
+// zones by numeric suffix (thermal_zone3 cannot be read and is skipped, thermal_zone4 has no type),
+// then hwmon chips with temp<N>_label or temp<N> as label; crit/label files and cooling devices are ignored.
+// The acpitz zone is also hwmon2 and x86_pkg_temp is coretemp's package, so both zones are duplicates.
+static const Expected EXPECTED[] = {
+    {"acpitz", "acpitz", 27.8f, false, true},
+    {"x86_pkg_temp", "x86_pkg_temp", 55.0f, true, true},
+    {"thermal_zone4", "thermal_zone4", 30.5f, false, false},
+    {"iwlwifi_1", "iwlwifi_1", 68.0f, false, false},
+    {"coretemp/Package id 0", "coretemp", 57.0f, true, false},
+    {"coretemp/Core 0", "coretemp", 52.0f, true, false},
+    {"coretemp/temp10", "coretemp", 53.0f, true, false},
+    {"nvme/temp1", "nvme", -5.0f, false, false},
+    {"acpitz/temp1", "acpitz", 27.8f, false, false},
+};
+
+static int failures = 0;
+
+static void check(bool ok, const std::string &what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+static bool near(float a, float b) {
+    return std::fabs(a - b) < 0.01f;
+}
+
+int main(int argc, char **argv) {
+    const std::string root = (argc > 1) ? argv[1] : THERMAL_FIXTURE_DIR;
+    const size_t count = sizeof(EXPECTED) / sizeof(EXPECTED[0]);
+
+    ThermalSensors sensors(root);
+    const auto &found = sensors.sensors();
+    check(found.size() == count, "found " + std::to_string(found.size()) + " sensors, expected " +
+                                     std::to_string(count));
+
+    ThermalSensors::Reading reading;
+    check(sensors.read(reading), "read() failed");
+
+    for (size_t i = 0; i < count && i < found.size(); ++i) {
+        check(found[i].label == EXPECTED[i].label,
+              "sensor " + std::to_string(i) + " label \"" + found[i].label + "\", expected \"" + EXPECTED[i].label + "\"");
+        check(found[i].type == EXPECTED[i].type,
+              "sensor " + std::to_string(i) + " type \"" + found[i].type + "\", expected \"" + EXPECTED[i].type + "\"");
+        check(found[i].cpu == EXPECTED[i].cpu, "sensor " + std::to_string(i) + " (" + EXPECTED[i].label + ") cpu flag");
+        check(found[i].duplicate == EXPECTED[i].duplicate,
+              "sensor " + std::to_string(i) + " (" + EXPECTED[i].label + ") duplicate flag");
+        check(i < reading.perSensorC.size() && near(reading.perSensorC[i], EXPECTED[i].celsius),
+              "sensor " + std::to_string(i) + " (" + EXPECTED[i].label + ") value");
+    }
+
+    float sum = 0.0f;
+    size_t averaged = 0;
+    for (const Expected &e : EXPECTED) {
+        if (!e.duplicate) {
+            sum += e.celsius;
+            ++averaged;
+        }
+    }
+    // the wifi zone is the hottest sensor, but the CPU temperature comes from CPU sensors only
+    check(near(reading.maxC, 68.0f), "max " + std::to_string(reading.maxC) + ", expected 68");
+    check(near(reading.cpuC, 57.0f), "cpu " + std::to_string(reading.cpuC) + ", expected 57");
+    check(near(reading.avgC, sum / averaged), "avg " + std::to_string(reading.avgC));
+
+    // a root without sensors reports nothing instead of a fake 0
+    ThermalSensors empty(root + "/does-not-exist");
+    ThermalSensors::Reading none;
+    check(empty.sensors().empty(), "sensors found under a missing root");
+    check(!empty.read(none), "read() succeeded without sensors");
+
+    std::cout << (failures == 0 ? "thermal sensor discovery OK\n" : "thermal sensor discovery FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// collectors.cpp
+#include "collectors.hpp"
+
+#include <unistd.h>
+
+static const char *PROC_DISKSTATS = "/diskstats";
+static const char *PROC_NET_DEV   = "/net/dev";
+
+static double toSeconds(Collector::Duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+// devices keep their order between reads, so the same index is tried first
+template <typename Stats>
+static const Stats *findPrevious(const std::vector<Stats> &previous, size_t hint, const std::string &name) {
+    if (hint < previous.size() && previous[hint].name == name) {
+        return &previous[hint];
+    }
+    for (const Stats &s : previous) {
+        if (s.name == name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+// ---------------- disk ----------------
+
+DiskCollector::DiskCollector(const std::string &procRoot)
+    : file_(procRoot + PROC_DISKSTATS),
+      sysBlockDir_(procRoot + "/../sys/block/") {
+}
+
+void DiskCollector::collect(Duration elapsed, std::vector<MetricPlain> &out) {
+    std::string_view text;
+    if (!file_.read(text) || !parseDiskstats(text, current_)) {
+        return;
+    }
+
+    double elapsedMs = toSeconds(elapsed) * 1000.0;
+    for (size_t i = 0; elapsedMs > 0 && i < current_.size(); ++i) {
+        const DiskStats &now = current_[i];
+        if (now.ioTicksMs == 0) {
+            continue; // never used (idle loop/ram devices)
+        }
+
+        auto whole = wholeDisk_.find(now.name);
+        if (whole == wholeDisk_.end()) {
+            bool isDisk = ::access((sysBlockDir_ + now.name).c_str(), F_OK) == 0;
+            whole = wholeDisk_.emplace(now.name, isDisk).first;
+        }
+        const DiskStats *before = findPrevious(previous_, i, now.name);
+        if (!whole->second || !before) {
+            continue;
+        }
+
+        double util = static_cast<double>(counterDelta(before->ioTicksMs, now.ioTicksMs)) * 100.0 / elapsedMs;
+        out.push_back(MetricPlain{"DISK", now.name, static_cast<float>(util > 100.0 ? 100.0 : util)});
+    }
+
+    previous_.swap(current_);
+}
+
+// ---------------- network ----------------
+
+NetCollector::NetCollector(const std::string &procRoot)
+    : file_(procRoot + PROC_NET_DEV) {
+}
+
+void NetCollector::collect(Duration elapsed, std::vector<MetricPlain> &out) {
+    std::string_view text;
+    if (!file_.read(text) || !parseNetDev(text, current_)) {
+        return;
+    }
+
+    double seconds = toSeconds(elapsed);
+    for (size_t i = 0; seconds > 0 && i < current_.size(); ++i) {
+        const NetDevStats &now = current_[i];
+        if (now.name == "lo") {
+            continue;
+        }
+        const NetDevStats *before = findPrevious(previous_, i, now.name);
+        if (!before) {
+            continue;
+        }
+
+        uint64_t bytes = counterDelta(before->rxBytes, now.rxBytes) + counterDelta(before->txBytes, now.txBytes);
+        double mbits = static_cast<double>(bytes) * 8.0 / 1e6 / seconds;
+        out.push_back(MetricPlain{"NET", now.name, static_cast<float>(mbits)});
+    }
+
+    previous_.swap(current_);
+}
+
+// ---------------- pressure stall ----------------
+
+PressureCollector::Resource::Resource(const std::string &procRoot, const char *name)
+    : label(name),
+      file(procRoot + "/pressure/" + name) {
+}
+
+PressureCollector::PressureCollector(const std::string &procRoot) {
+    for (const char *name : {"cpu", "memory", "io"}) {
+        resources_.push_back(std::make_unique<Resource>(procRoot, name));
+    }
+}
+
+void PressureCollector::collect(Duration elapsed, std::vector<MetricPlain> &out) {
+    // the kernel's avg10 is a 10 s average; the total counter gives the stall share of this tick
+    double elapsedUs = toSeconds(elapsed) * 1e6;
+    for (auto &res : resources_) {
+        std::string_view text;
+        uint64_t totalUs = 0;
+        if (!res->file.read(text) || !parsePressureTotal(text, totalUs)) {
+            continue;
+        }
+        if (res->havePrevious && elapsedUs > 0) {
+            double pct = static_cast<double>(counterDelta(res->previousUs, totalUs)) * 100.0 / elapsedUs;
+            out.push_back(MetricPlain{"PRESSURE", res->label, static_cast<float>(pct > 100.0 ? 100.0 : pct)});
+        }
+        res->previousUs = totalUs;
+        res->havePrevious = true;
+    }
+}
+
+// ---------------- per process ----------------
+
+ProcessCollector::Process::Process(const std::string &procRoot, int pid)
+    : pid(pid),
+      file(procRoot + "/" + std::to_string(pid) + "/stat") {
+}
+
+ProcessCollector::ProcessCollector(const std::vector<int> &pids, const std::string &procRoot)
+    : ticksPerSecond_(static_cast<double>(::sysconf(_SC_CLK_TCK))) {
+    for (int pid : pids) {
+        processes_.push_back(std::make_unique<Process>(procRoot, pid));
+    }
+    if (ticksPerSecond_ <= 0) {
+        ticksPerSecond_ = 100.0;
+    }
+}
+
+void ProcessCollector::collect(Duration elapsed, std::vector<MetricPlain> &out) {
+    double seconds = toSeconds(elapsed);
+    for (auto &proc : processes_) {
+        // an exited process fails the read (ESRCH) and just stops reporting
+        std::string_view text;
+        if (!proc->file.read(text) || !parsePidStat(text, proc->stat)) {
+            proc->havePrevious = false;
+            continue;
+        }
+
+        uint64_t ticks = proc->stat.utimeTicks + proc->stat.stimeTicks;
+        if (proc->havePrevious && seconds > 0) {
+            double pct = static_cast<double>(counterDelta(proc->previousTicks, ticks)) * 100.0
+                         / ticksPerSecond_ / seconds;
+            out.push_back(MetricPlain{"PROC",
+                                      std::to_string(proc->pid) + "(" + proc->stat.comm + ")",
+                                      static_cast<float>(pct)});
+        }
+        proc->previousTicks = ticks;
+        proc->havePrevious = true;
+    }
+}
\ No newline at end of file
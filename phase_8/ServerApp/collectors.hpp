@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "proc_reader.hpp"
+
+// One value produced by a collector on a sampler tick.
+struct MetricPlain {
+    std::string source;   // "DISK" | "NET" | "PRESSURE" | "PROC", the logger's TelemetrySrc_enum name
+    std::string label;    // device, interface, resource or "pid(comm)"
+    float       value = 0.0f;
+};
+
+// A source of extra metrics driven by the TelemetrySampler's tick, so adding
+// one adds no thread. Collectors keep their own ProcFiles and previous counters;
+// the sampler only tells them how much time passed since the last call.
+// procRoot is "/proc" unless the sampler runs on another root.
+class Collector {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    virtual ~Collector() = default;
+
+    // elapsed is zero on the first call, which only records the baseline
+    virtual void collect(Duration elapsed, std::vector<MetricPlain> &out) = 0;
+};
+
+// Utilisation (% of wall time with I/O in flight) of every whole block device.
+class DiskCollector : public Collector {
+public:
+    explicit DiskCollector(const std::string &procRoot = "/proc");
+    void collect(Duration elapsed, std::vector<MetricPlain> &out) override;
+
+private:
+    ProcFile file_;
+    std::vector<DiskStats> current_;
+    std::vector<DiskStats> previous_;
+    std::string sysBlockDir_;                          // <procRoot>/../sys/block/
+    std::unordered_map<std::string, bool> wholeDisk_;  // partitions have no /sys/block entry
+};
+
+// Receive + transmit throughput in Mbit/s of every interface but loopback.
+class NetCollector : public Collector {
+public:
+    explicit NetCollector(const std::string &procRoot = "/proc");
+    void collect(Duration elapsed, std::vector<MetricPlain> &out) override;
+
+private:
+    ProcFile file_;
+    std::vector<NetDevStats> current_;
+    std::vector<NetDevStats> previous_;
+};
+
+// Share of the interval in which some task stalled on cpu, memory or io (PSI).
+// Kernels without CONFIG_PSI simply produce nothing.
+class PressureCollector : public Collector {
+public:
+    explicit PressureCollector(const std::string &procRoot = "/proc");
+    void collect(Duration elapsed, std::vector<MetricPlain> &out) override;
+
+private:
+    struct Resource {
+        Resource(const std::string &procRoot, const char *name);
+        std::string label;
+        ProcFile file;
+        uint64_t previousUs = 0;
+        bool havePrevious = false;
+    };
+    std::vector<std::unique_ptr<Resource>> resources_;
+};
+
+// CPU usage of a fixed list of PIDs, top-style (100 = one full core).
+class ProcessCollector : public Collector {
+public:
+    explicit ProcessCollector(const std::vector<int> &pids, const std::string &procRoot = "/proc");
+    void collect(Duration elapsed, std::vector<MetricPlain> &out) override;
+
+private:
+    struct Process {
+        Process(const std::string &procRoot, int pid);
+        int pid;
+        ProcFile file;
+        PidStat stat;
+        uint64_t previousTicks = 0;
+        bool havePrevious = false;
+    };
+    std::vector<std::unique_ptr<Process>> processes_;
+    double ticksPerSecond_;
+};
@@ -0,0 +1,289 @@
+// proc_reader.cpp
+#include "proc_reader.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+ProcFile::ProcFile(std::string path)
+    : path_(std::move(path)), buffer_(4096) {
+    fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ == -1) {
+        std::cerr << "[Telemetry] Failed to open " << path_ << "\n";
+    }
+}
+
+ProcFile::~ProcFile() {
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+}
+
+void ProcFile::replay(const std::vector<std::string> *frames, const size_t *cursor) {
+    replayFrames_ = frames;
+    replayCursor_ = cursor;
+}
+
+bool ProcFile::read(std::string_view &out) {
+    if (replayFrames_) {
+        if (replayFrames_->empty()) {
+            return false;
+        }
+        out = (*replayFrames_)[*replayCursor_ % replayFrames_->size()];
+        return true;
+    }
+    if (fd_ == -1) {
+        return false;
+    }
+
+    // proc files report size 0, so grow until a read comes back short
+    while (true) {
+        size_t total = 0;
+        while (total < buffer_.size()) {
+            ssize_t n = ::pread(fd_, buffer_.data() + total, buffer_.size() - total,
+                                static_cast<off_t>(total));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (n == 0) {
+                break;
+            }
+            total += static_cast<size_t>(n);
+        }
+        if (total < buffer_.size()) {
+            out = std::string_view(buffer_.data(), total);
+            return true;
+        }
+        buffer_.resize(buffer_.size() * 2);
+    }
+}
+
+bool parseProcStat(std::string_view text, std::vector<CpuTimes> &times) {
+    times.clear();
+
+    const char *p = text.data();
+    const char *end = p + text.size();
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) {
+            eol = end;
+        }
+
+        if (eol - p > 3 && memcmp(p, "cpu", 3) == 0) {
+            // Skip the aggregate "cpu " line; we only want cpu0, cpu1, ...
+            if (static_cast<unsigned char>(p[3] - '0') <= 9) {
+                const char *q = p + 3;
+                while (q < eol && *q != ' ') {
+                    ++q;
+                }
+                CpuTimes ct;
+                uint64_t *fields[] = {&ct.user, &ct.nice, &ct.system, &ct.idle,
+                                      &ct.iowait, &ct.irq, &ct.softirq, &ct.steal};
+                for (uint64_t *field : fields) {
+                    if (!scanU64(q, eol, *field)) {
+                        break; // older kernels have fewer columns
+                    }
+                }
+                times.push_back(ct);
+            }
+        } else if (!times.empty()) {
+            break; // cpu lines come first; the rest (intr, ctxt, ...) is not needed
+        }
+        p = eol + 1;
+    }
+
+    return !times.empty();
+}
+
+bool parseProcMeminfo(std::string_view text, uint64_t &memTotalKb, uint64_t &memAvailableKb) {
+    memTotalKb = 0;
+    memAvailableKb = 0;
+    bool haveTotal = false;
+    bool haveAvailable = false;
+
+    const char *p = text.data();
+    const char *end = p + text.size();
+    while (p < end && !(haveTotal && haveAvailable)) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) {
+            eol = end;
+        }
+        size_t len = static_cast<size_t>(eol - p);
+        if (len > 9 && memcmp(p, "MemTotal:", 9) == 0) {
+            const char *q = p + 9;
+            haveTotal = scanU64(q, eol, memTotalKb);
+        } else if (len > 13 && memcmp(p, "MemAvailable:", 13) == 0) {
+            const char *q = p + 13;
+            haveAvailable = scanU64(q, eol, memAvailableKb);
+        }
+        p = eol + 1;
+    }
+
+    return haveTotal;
+}
+
+bool parseSignedValue(std::string_view text, long &out) {
+    const char *p = text.data();
+    const char *end = p + text.size();
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    bool negative = (p < end && *p == '-');
+    if (negative) {
+        ++p;
+    }
+    uint64_t v = 0;
+    if (!scanU64(p, end, v)) {
+        return false;
+    }
+    out = negative ? -static_cast<long>(v) : static_cast<long>(v);
+    return true;
+}
+
+// Skips blanks, then returns the next blank-delimited word and advances p past it.
+static std::string_view scanWord(const char *&p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    const char *start = p;
+    while (p < end && *p != ' ' && *p != '\t') {
+        ++p;
+    }
+    return std::string_view(start, static_cast<size_t>(p - start));
+}
+
+bool parseDiskstats(std::string_view text, std::vector<DiskStats> &disks) {
+    size_t count = 0;
+
+    const char *p = text.data();
+    const char *end = p + text.size();
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) {
+            eol = end;
+        }
+
+        // major minor name reads merged sectorsRead ms writes merged sectorsWritten ms inFlight ioTicks ...
+        uint64_t major = 0, minor = 0;
+        uint64_t f[10];
+        const char *q = p;
+        bool ok = scanU64(q, eol, major) && scanU64(q, eol, minor);
+        std::string_view name = ok ? scanWord(q, eol) : std::string_view();
+        for (uint64_t &field : f) {
+            ok = ok && scanU64(q, eol, field);
+        }
+        if (ok && !name.empty()) {
+            if (count == disks.size()) {
+                disks.emplace_back();
+            }
+            DiskStats &d = disks[count++];
+            d.name.assign(name.data(), name.size());
+            d.sectorsRead = f[2];
+            d.sectorsWritten = f[6];
+            d.ioTicksMs = f[9];
+        }
+        p = eol + 1;
+    }
+
+    disks.resize(count);
+    return count != 0;
+}
+
+bool parseNetDev(std::string_view text, std::vector<NetDevStats> &ifaces) {
+    size_t count = 0;
+
+    const char *p = text.data();
+    const char *end = p + text.size();
+    while (p < end) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) {
+            eol = end;
+        }
+
+        // "  eth0: rxBytes rxPackets errs drop fifo frame compressed multicast txBytes ..."
+        // the two header lines have no ':' before their first '|'
+        const char *colon = static_cast<const char *>(memchr(p, ':', static_cast<size_t>(eol - p)));
+        if (colon) {
+            const char *n = p;
+            while (n < colon && *n == ' ') {
+                ++n;
+            }
+            const char *q = colon + 1;
+            uint64_t f[9];
+            bool ok = n < colon;
+            for (uint64_t &field : f) {
+                ok = ok && scanU64(q, eol, field);
+            }
+            if (ok) {
+                if (count == ifaces.size()) {
+                    ifaces.emplace_back();
+                }
+                NetDevStats &i = ifaces[count++];
+                i.name.assign(n, static_cast<size_t>(colon - n));
+                i.rxBytes = f[0];
+                i.txBytes = f[8];
+            }
+        }
+        p = eol + 1;
+    }
+
+    ifaces.resize(count);
+    return count != 0;
+}
+
+bool parsePressureTotal(std::string_view text, uint64_t &someTotalUs) {
+    // "some avg10=0.00 avg60=0.00 avg300=0.00 total=12345"
+    if (text.size() < 5 || memcmp(text.data(), "some ", 5) != 0) {
+        return false;
+    }
+    const char *end = text.data() + text.size();
+    const char *eol = static_cast<const char *>(memchr(text.data(), '\n', text.size()));
+    if (eol) {
+        end = eol;
+    }
+    static constexpr char KEY[] = "total=";
+    std::string_view line(text.data(), static_cast<size_t>(end - text.data()));
+    size_t pos = line.find(KEY);
+    if (pos == std::string_view::npos) {
+        return false;
+    }
+    const char *q = line.data() + pos + sizeof(KEY) - 1;
+    return scanU64(q, end, someTotalUs);
+}
+
+bool parsePidStat(std::string_view text, PidStat &out) {
+    // "pid (comm) state ppid ..." - comm is whatever lies between the first '(' and the last ')'
+    size_t open = text.find('(');
+    size_t close = text.rfind(')');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open) {
+        return false;
+    }
+    out.comm.assign(text.data() + open + 1, close - open - 1);
+
+    const char *q = text.data() + close + 1;
+    const char *end = text.data() + text.size();
+    // field 3 is the state letter; utime/stime are fields 14/15, rss is field 24
+    scanWord(q, end);
+    // tpgid, priority and nice can be negative, so the fields in between are skipped as words
+    for (int field = 4; field <= 24; ++field) {
+        bool ok = true;
+        if (field == 14) {
+            ok = scanU64(q, end, out.utimeTicks);
+        } else if (field == 15) {
+            ok = scanU64(q, end, out.stimeTicks);
+        } else if (field == 24) {
+            ok = scanU64(q, end, out.rssPages);
+        } else {
+            ok = !scanWord(q, end).empty();
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct CpuTimes {
+    uint64_t user    = 0;
+    uint64_t nice    = 0;
+    uint64_t system  = 0;
+    uint64_t idle    = 0;
+    uint64_t iowait  = 0;
+    uint64_t irq     = 0;
+    uint64_t softirq = 0;
+    uint64_t steal   = 0;
+};
+
+// Counters from /proc/diskstats for one block device.
+struct DiskStats {
+    std::string name;
+    uint64_t sectorsRead    = 0;
+    uint64_t sectorsWritten = 0;
+    uint64_t ioTicksMs      = 0;  // time the device had I/O in flight
+};
+
+// Byte counters from /proc/net/dev for one interface.
+struct NetDevStats {
+    std::string name;
+    uint64_t rxBytes = 0;
+    uint64_t txBytes = 0;
+};
+
+// Fields of /proc/<pid>/stat used for per-process load.
+struct PidStat {
+    std::string comm;
+    uint64_t utimeTicks = 0;
+    uint64_t stimeTicks = 0;
+    uint64_t rssPages   = 0;
+};
+
+// A /proc or /sys file opened once and re-read from offset 0 with pread, so a
+// sample costs one syscall and no allocation once the buffer has grown to fit.
+class ProcFile {
+public:
+    explicit ProcFile(std::string path);
+    ~ProcFile();
+
+    ProcFile(const ProcFile &) = delete;
+    ProcFile &operator=(const ProcFile &) = delete;
+
+    bool isOpen() const { return fd_ != -1; }
+    const std::string &path() const { return path_; }
+
+    // Reads the whole file; the view stays valid until the next read.
+    bool read(std::string_view &out);
+
+    // From now on read() serves (*frames)[*cursor] from memory instead of the
+    // file, so a recorded sequence can be replayed without touching the disk.
+    // Both pointers must outlive this ProcFile.
+    void replay(const std::vector<std::string> *frames, const size_t *cursor);
+
+private:
+    std::string path_;
+    int fd_ = -1;
+    std::vector<char> buffer_;
+    const std::vector<std::string> *replayFrames_ = nullptr;
+    const size_t *replayCursor_ = nullptr;
+};
+
+// Hand-written scanners for the kernel's text formats: no streams, no locale,
+// no temporary strings.
+
+// Skips blanks, then parses an unsigned decimal and advances p past it.
+inline bool scanU64(const char *&p, const char *end, uint64_t &out) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    if (p == end || static_cast<unsigned char>(*p - '0') > 9) {
+        return false;
+    }
+    uint64_t v = 0;
+    while (p < end && static_cast<unsigned char>(*p - '0') <= 9) {
+        v = v * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    out = v;
+    return true;
+}
+
+// Per-core "cpuN ..." lines of /proc/stat; the aggregate "cpu " line is skipped.
+bool parseProcStat(std::string_view text, std::vector<CpuTimes> &times);
+
+// MemTotal and MemAvailable from /proc/meminfo, in kB.
+bool parseProcMeminfo(std::string_view text, uint64_t &memTotalKb, uint64_t &memAvailableKb);
+
+// A single, possibly negative, integer such as a sysfs temperature.
+bool parseSignedValue(std::string_view text, long &out);
+
+// All devices in /proc/diskstats; entries of `disks` are reused to keep their name buffers.
+bool parseDiskstats(std::string_view text, std::vector<DiskStats> &disks);
+
+// All interfaces in /proc/net/dev, same reuse as parseDiskstats.
+bool parseNetDev(std::string_view text, std::vector<NetDevStats> &ifaces);
+
+// The cumulative "some ... total=<us>" stall time of a /proc/pressure file.
+bool parsePressureTotal(std::string_view text, uint64_t &someTotalUs);
+
+// comm, utime, stime and rss of /proc/<pid>/stat; comm may contain blanks and parentheses.
+bool parsePidStat(std::string_view text, PidStat &out);
+
+// Difference of two cumulative kernel counters, clamped at zero because some
+// (iowait, counters of a replaced device) can go backwards.
+inline uint64_t counterDelta(uint64_t before, uint64_t after) {
+    return after > before ? after - before : 0;
+}
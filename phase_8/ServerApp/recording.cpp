@@ -0,0 +1,89 @@
+// recording.cpp
+#include "recording.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "proc_reader.hpp"
+
+bool Recording::load(const std::string &dir) {
+    root_ = dir + "/root/";
+    timestamps_.clear();
+    files_.clear();
+
+    std::ifstream in(dir + "/frames", std::ios::binary);
+    if (!in) {
+        std::cerr << "[Telemetry] No recording at " << dir << "\n";
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    const char *p = data.data();
+    const char *end = p + data.size();
+    auto expectWord = [&](std::string_view word) {
+        if (static_cast<size_t>(end - p) < word.size() || std::string_view(p, word.size()) != word) {
+            return false;
+        }
+        p += word.size();
+        return true;
+    };
+
+    while (p < end) {
+        uint64_t timestampMs = 0;
+        uint64_t fileCount = 0;
+        if (!expectWord("frame") || !scanU64(p, end, timestampMs) || !scanU64(p, end, fileCount) ||
+            !expectWord("\n")) {
+            std::cerr << "[Telemetry] Malformed frame header in " << dir << "/frames\n";
+            return false;
+        }
+
+        size_t frame = timestamps_.size();
+        timestamps_.push_back(timestampMs);
+        for (uint64_t i = 0; i < fileCount; ++i) {
+            const char *space = p;
+            while (space < end && *space != ' ') {
+                ++space;
+            }
+            std::string path(p, static_cast<size_t>(space - p));
+            p = space;
+            uint64_t bytes = 0;
+            if (path.empty() || !scanU64(p, end, bytes) || !expectWord("\n") ||
+                static_cast<uint64_t>(end - p) < bytes) {
+                std::cerr << "[Telemetry] Malformed file entry in frame " << frame << "\n";
+                return false;
+            }
+
+            // a file missing from earlier frames repeats its first recorded contents
+            std::vector<std::string> &contents = files_[path];
+            std::string current(p, static_cast<size_t>(bytes));
+            while (contents.size() < frame) {
+                contents.push_back(current);
+            }
+            contents.push_back(std::move(current));
+            p += bytes;
+        }
+    }
+
+    // ... and one missing from later frames keeps its last contents
+    for (auto &entry : files_) {
+        while (entry.second.size() < timestamps_.size()) {
+            entry.second.push_back(entry.second.back());
+        }
+    }
+
+    return !timestamps_.empty();
+}
+
+const std::vector<std::string> *Recording::frames(const std::string &relPath) const {
+    auto it = files_.find(relPath);
+    return it == files_.end() ? nullptr : &it->second;
+}
+
+void Recording::writeFrame(std::ostream &out, uint64_t timestampMs, const FileContents &files) {
+    out << "frame " << timestampMs << ' ' << files.size() << '\n';
+    for (const auto &file : files) {
+        out << file.first << ' ' << file.second.size() << '\n';
+        out.write(file.second.data(), static_cast<std::streamsize>(file.second.size()));
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A sequence of /proc and /sys snapshots captured by telemetry_record.
+//
+// Layout of a recording directory:
+//   root/     copy of every recorded file (first frame) plus the sysfs
+//             attributes needed for discovery (thermal "type", hwmon "name"...)
+//   frames    for each frame:  "frame <timestampMs> <fileCount>\n"
+//             then per file:   "<path relative to root> <bytes>\n<bytes>"
+class Recording {
+public:
+    // false if <dir>/frames is missing or malformed
+    bool load(const std::string &dir);
+
+    const std::string &root() const { return root_; }
+    size_t frameCount() const { return timestamps_.size(); }
+    uint64_t timestampMs(size_t frame) const { return timestamps_[frame % timestamps_.size()]; }
+
+    // contents of one file in every frame, or nullptr if it was not recorded;
+    // relPath has no leading slash, e.g. "proc/stat"
+    const std::vector<std::string> *frames(const std::string &relPath) const;
+
+    // writer side, used by telemetry_record
+    using FileContents = std::vector<std::pair<std::string, std::string_view>>;
+    static void writeFrame(std::ostream &out, uint64_t timestampMs, const FileContents &files);
+
+private:
+    std::string root_;
+    std::vector<uint64_t> timestamps_;
+    std::unordered_map<std::string, std::vector<std::string>> files_;
+};
@@ -1,56 +1,211 @@
 #include <CommonAPI/CommonAPI.hpp>
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include "../common-api/src-gen/v1/v1/logger/methods/loggingStubDefault.hpp"
 #include "../common-api/src-gen/v1/v1/logger/methods/TelemetryTypes.hpp"
 #include "telemetry_sampler.hpp"
+#include "policies.hpp"
+#include "shmring.hpp"
 
+// defaults, override with: server <publish_ms> <batch_size> [pid,pid,...]
+// TELEMETRY_ROOT=<dir> samples <dir>/proc and <dir>/sys instead of the host's,
+// TELEMETRY_REPLAY=<dir> replays a recording made with telemetry_record,
+// TELEMETRY_SAMPLE_US=<us> samples faster than publish_ms (batches carry every sample),
+// TELEMETRY_FAST_US=<us> switches to that interval while a value is above its policy WARNING,
+// TELEMETRY_HOLD_MS=<ms> is how long to stay fast after the last hot sample (default 2000)
+// TELEMETRY_SHM=<name> also publishes every sample into the shared-memory ring /<name>
+static constexpr int DEFAULT_PUBLISH_MS = 250;  // period of the telemetryUpdate broadcast
+static constexpr int DEFAULT_BATCH_SIZE = 4;    // samples per telemetryBatch broadcast
 
+static v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot makeSnapshot(bool ok, const TelemetrySnapshotPlain &plain)
+{
+    if (!ok) {
+        return v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot(
+            "0",  // coreLoads
+            0u,   // slot1 = temperatureC  → sending ram here
+            0u    // slot2 = ramUsagePercentage → sending temp here
+        );
+    }
+
+    // Constructor: (coreLoads, temperatureC_slot, ramUsagePercentage_slot)
+    // We intentionally swap so the receiver sees ram in temp field and temp in ram field
+    return v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot(
+        plain.coreLoads,
+        static_cast<uint16_t>(plain.ramUsagePercent),  // ram → temperatureC slot
+        static_cast<uint32_t>(plain.temperatureC)      // temp → ramUsagePercentage slot
+    );
+}
+
+static long envOr(const char *name, long fallback)
+{
+    const char *value = std::getenv(name);
+    return value ? std::atol(value) : fallback;
+}
+
+// same thresholds the logger uses to raise WARNING lines
+static bool isHot(const TelemetrySnapshotPlain &plain)
+{
+    for (const CoreLoadPlain &core : plain.cores) {
+        if (core.total > CpuPolicy::WARNING) {
+            return true;
+        }
+    }
+    if (plain.ramUsagePercent > RamPolicy::WARNING || plain.temperatureC > TempPolicy::WARNING) {
+        return true;
+    }
+    for (const MetricPlain &metric : plain.metrics) {
+        if ((metric.source == "DISK" && metric.value > DiskPolicy::WARNING) ||
+            (metric.source == "PRESSURE" && metric.value > PressurePolicy::WARNING)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static SeverityLvl_enum severityOf(TelemetrySrc_enum context, float value)
+{
+    switch (context) {
+    case TelemetrySrc_enum::CPU:      return CpuPolicy::inferSeverity(value);
+    case TelemetrySrc_enum::TEMP:     return TempPolicy::inferSeverity(value);
+    case TelemetrySrc_enum::RAM:      return RamPolicy::inferSeverity(value);
+    case TelemetrySrc_enum::DISK:     return DiskPolicy::inferSeverity(value);
+    case TelemetrySrc_enum::NET:      return NetPolicy::inferSeverity(value);
+    case TelemetrySrc_enum::PRESSURE: return PressurePolicy::inferSeverity(value);
+    case TelemetrySrc_enum::PROC:     return ProcPolicy::inferSeverity(value);
+    }
+    return SeverityLvl_enum::INFO;
+}
+
+// the same values the batch broadcast carries; labels follow shmring.hpp
+static void publishToShm(ShmRingWriter &ring, const TelemetrySnapshotPlain &plain)
+{
+    auto publish = [&](TelemetrySrc_enum context, std::string_view label, float value) {
+        ring.publish(ShmRecord::make(plain.timestampMs, context, severityOf(context, value), label, value));
+    };
+
+    unsigned sum = 0;
+    char core[16];
+    for (size_t i = 0; i < plain.cores.size(); ++i) {
+        sum += plain.cores[i].total;
+        auto [end, ec] = std::to_chars(core, core + sizeof(core), i);
+        (void)ec;
+        publish(TelemetrySrc_enum::CPU, std::string_view(core, static_cast<size_t>(end - core)),
+                plain.cores[i].total);
+    }
+    float cpu = plain.cores.empty() ? 0.0f : static_cast<float>(sum / plain.cores.size());
+    publish(TelemetrySrc_enum::CPU, {}, cpu);
+    publish(TelemetrySrc_enum::RAM, {}, static_cast<float>(plain.ramUsagePercent));
+    publish(TelemetrySrc_enum::TEMP, {}, static_cast<float>(plain.temperatureC));
+
+    for (const MetricPlain &metric : plain.metrics) {
+        auto context = magic_enum::enum_cast<TelemetrySrc_enum>(metric.source);
+        if (context) {
+            publish(*context, metric.label, metric.value);
+        }
+    }
+    ring.notify();
+}
+
+static v1::v1::logger::methods::TelemetryTypes::TelemetrySample makeSample(const TelemetrySnapshotPlain &plain)
+{
+    std::vector<v1::v1::logger::methods::TelemetryTypes::CoreLoad> cores;
+    cores.reserve(plain.cores.size());
+    for (const CoreLoadPlain &core : plain.cores) {
+        cores.emplace_back(core.total, core.user, core.system, core.iowait, core.steal);
+    }
+
+    std::vector<v1::v1::logger::methods::TelemetryTypes::Metric> metrics;
+    metrics.reserve(plain.metrics.size());
+    for (const MetricPlain &metric : plain.metrics) {
+        metrics.emplace_back(metric.source, metric.label, metric.value);
+    }
+
+    // typed fields carry the real values; no slot swapping here
+    return v1::v1::logger::methods::TelemetryTypes::TelemetrySample(
+        plain.timestampMs,
+        cores,
+        plain.ramUsagePercent,
+        plain.temperatureC,
+        metrics
+    );
+}
 
 class TelemetryLoggingStub
     : public v1::v1::logger::methods::loggingStubDefault {
 public:
-    TelemetryLoggingStub() = default;
+    explicit TelemetryLoggingStub(const TelemetrySampler &sampler)
+        : sampler_(sampler) {}
 
+    // answered from the sampler's cache, no /proc access on the call path
     virtual void requestData(
         const std::shared_ptr<CommonAPI::ClientId> _client,
         requestDataReply_t _reply) override
     {
         (void)_client;
 
-        TelemetrySnapshotPlain plain{};
-
-        if (!TelemetrySampler::sample(plain)) {
-            v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot snap(
-                "0",  // coreLoads
-                0u,   // slot1 = temperatureC  → sending ram here
-                0u    // slot2 = ramUsagePercentage → sending temp here
-            );
-            _reply(snap);
-            return;
-        }
-
-        // Constructor: (coreLoads, temperatureC_slot, ramUsagePercentage_slot)
-        // We intentionally swap so the receiver sees ram in temp field and temp in ram field
-        v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot snap(
-            plain.coreLoads,
-            static_cast<uint16_t>(plain.ramUsagePercent),  // ram → temperatureC slot
-            static_cast<uint32_t>(plain.temperatureC)      // temp → ramUsagePercentage slot
-        );
-        _reply(snap);
+        auto latest = sampler_.latestShared();
+        _reply(latest ? makeSnapshot(true, *latest) : makeSnapshot(false, TelemetrySnapshotPlain{}));
     }
+
+private:
+    const TelemetrySampler &sampler_;
 };
 
 
-int main() {
+int main(int argc, char **argv) {
+    int publishMs = (argc > 1) ? std::atoi(argv[1]) : DEFAULT_PUBLISH_MS;
+    if (publishMs <= 0) {
+        publishMs = DEFAULT_PUBLISH_MS;
+    }
+    int batchSize = (argc > 2) ? std::atoi(argv[2]) : DEFAULT_BATCH_SIZE;
+    if (batchSize <= 0) {
+        batchSize = DEFAULT_BATCH_SIZE;
+    }
+
     auto runtime = CommonAPI::Runtime::get();
     if (!runtime) {
         std::cerr << "[Server] Failed to get CommonAPI runtime!\n";
         return 1;
     }
 
-    auto stub = std::make_shared<TelemetryLoggingStub>();
+    const char *rootEnv = std::getenv("TELEMETRY_ROOT");
+    const char *replayEnv = std::getenv("TELEMETRY_REPLAY");
+    const std::chrono::microseconds samplePeriod{envOr("TELEMETRY_SAMPLE_US", publishMs * 1000L)};
+    TelemetrySampler sampler{samplePeriod,
+                             rootEnv ? rootEnv : "/",
+                             replayEnv ? replayEnv : ""};
+
+    TelemetrySampler::AdaptiveOptions adaptive;
+    adaptive.fastPeriod = std::chrono::microseconds(envOr("TELEMETRY_FAST_US", 0));
+    adaptive.hold = std::chrono::milliseconds(envOr("TELEMETRY_HOLD_MS", 2000));
+    adaptive.isHot = isHot;
+    sampler.setAdaptive(adaptive);
+
+    const std::string procRoot = sampler.root() + "proc";
+    sampler.addCollector(std::make_unique<DiskCollector>(procRoot));
+    sampler.addCollector(std::make_unique<NetCollector>(procRoot));
+    sampler.addCollector(std::make_unique<PressureCollector>(procRoot));
+    if (argc > 3) {
+        // comma separated PIDs to follow, e.g. "1234,5678"
+        std::vector<int> pids;
+        for (const char *p = argv[3]; *p != '\0';) {
+            char *end = nullptr;
+            long pid = std::strtol(p, &end, 10);
+            if (end == p) {
+                ++p;
+                continue;
+            }
+            if (pid > 0) {
+                pids.push_back(static_cast<int>(pid));
+            }
+            p = end;
+        }
+        sampler.addCollector(std::make_unique<ProcessCollector>(pids, procRoot));
+    }
+    auto stub = std::make_shared<TelemetryLoggingStub>(sampler);
 
     bool ok = runtime->registerService(
         "local",
@@ -63,7 +218,47 @@ int main() {
         return 1;
     }
 
-    std::cout << "[Server] Service registered, running..." << std::endl;
+    std::cout << "[Server] Service registered, sampling every " << samplePeriod.count()
+              << " us, publishing every " << publishMs << " ms, batches of " << batchSize << "..." << std::endl;
+
+    // subscribers get every sample without asking; requestData stays available for pollers
+    // each broadcast is in its own eventgroup, so only subscribed ones go on the wire
+    v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch batch;
+    batch.reserve(static_cast<size_t>(batchSize));
+
+    // a fast-sampling many-core host publishes ~100 records per tick, so keep a few hundred ticks
+    const char *shmEnv = std::getenv("TELEMETRY_SHM");
+    std::unique_ptr<ShmRingWriter> shm;
+    if (shmEnv) {
+        shm = std::make_unique<ShmRingWriter>(shmEnv, 32768);
+        if (shm->isOpen()) {
+            std::cout << "[Server] Publishing samples to shared memory " << shm->getName() << std::endl;
+        }
+    }
+
+    // snapshots stay at the publish rate however fast the sampler ticks
+    const auto publishPeriod = std::chrono::milliseconds(publishMs);
+    auto lastPublish = std::chrono::steady_clock::time_point{};
+
+    // runs on the sampler thread, once per tick
+    sampler.setListener([&](const TelemetrySnapshotPlain &plain) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastPublish >= publishPeriod - publishPeriod / 8) {
+            stub->fireTelemetryUpdateEvent(makeSnapshot(true, plain));
+            lastPublish = now;
+        }
+
+        if (shm) {
+            publishToShm(*shm, plain);
+        }
+
+        batch.push_back(makeSample(plain));
+        if (batch.size() >= static_cast<size_t>(batchSize)) {
+            stub->fireTelemetryBatchEvent(batch);
+            batch.clear();
+        }
+    });
+    sampler.start();
 
     while (true) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -3,157 +3,353 @@
 
 #include <algorithm>
 #include <chrono>
-#include <fstream>
+#include <cmath>
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <thread>
 
-static const char *PROC_STAT_PATH    = "/proc/stat";
-static const char *PROC_MEMINFO      = "/proc/meminfo";
-// adjust if your CPU temp is in a different zone
-static const char *THERMAL_TEMP_PATH = "/sys/class/thermal/thermal_zone5/temp";
+// relative to the sampler root
+static const char *PROC_STAT_PATH    = "proc/stat";
+static const char *PROC_MEMINFO      = "proc/meminfo";
+static const char *SYSFS_DIR         = "sys";
 
-bool TelemetrySampler::sample(TelemetrySnapshotPlain &outSnapshot) {
-    // --- CPU loads ---
-    std::vector<std::uint8_t> coreLoads = computePerCoreLoads();
-    outSnapshot.coreLoads = buildCoreLoadsString(coreLoads);
+static std::string normalizeRoot(const std::string &root) {
+    if (root.empty()) {
+        return "/";
+    }
+    return root.back() == '/' ? root : root + "/";
+}
 
-    // --- RAM ---
-    outSnapshot.ramUsagePercent = readRamUsagePercent();
+TelemetrySampler::Files::Files(const std::string &root)
+    : stat(root + PROC_STAT_PATH),
+      meminfo(root + PROC_MEMINFO),
+      thermal(root + SYSFS_DIR) {
+}
 
-    // --- Temperature ---
-    outSnapshot.temperatureC = readCpuTemperatureC();
+TelemetrySampler::TelemetrySampler(std::chrono::microseconds period, const std::string &root,
+                                   const std::string &replayDir)
+    : replaying_(!replayDir.empty()),
+      root_(replaying_ ? normalizeRoot(replayDir) + "root/" : normalizeRoot(root)),
+      files_(root_),
+      period_(period.count() > 0 ? period : std::chrono::milliseconds(200)),
+      collectEvery_(std::max<std::chrono::microseconds>(period_, COLLECTOR_PERIOD_MIN)),
+      currentPeriodUs_(period_.count()) {
+    if (!replaying_) {
+        return;
+    }
 
-    // best-effort: always return true; tighten if needed
-    return true;
+    if (!recording_.load(replayDir)) {
+        // nothing to replay: the files under <replayDir>/root are read as they are
+        replaying_ = false;
+        return;
+    }
+    attachReplay(files_.stat);
+    attachReplay(files_.meminfo);
+    for (const auto &sensor : files_.thermal.sensors()) {
+        attachReplay(*sensor.file);
+    }
+    std::cout << "[Telemetry] Replaying " << recording_.frameCount() << " frame(s) from " << replayDir << "\n";
 }
 
-// ---------------- CPU helpers ----------------
+void TelemetrySampler::attachReplay(ProcFile &file) {
+    std::string relPath = file.path().substr(root_.size());
+    const std::vector<std::string> *frames = recording_.frames(relPath);
+    if (!frames) {
+        std::cerr << "[Telemetry] " << relPath << " is not in the recording, reading the root copy\n";
+        return;
+    }
+    file.replay(frames, &replayCursor_);
+}
+
+TelemetrySampler::~TelemetrySampler() {
+    stop();
+}
+
+void TelemetrySampler::setListener(Listener listener) {
+    listener_ = std::move(listener);
+}
+
+void TelemetrySampler::addCollector(std::unique_ptr<Collector> collector) {
+    collectors_.push_back(std::move(collector));
+}
+
+void TelemetrySampler::setAdaptive(AdaptiveOptions options) {
+    adaptive_ = std::move(options);
+    if (adaptive_.fastPeriod >= period_) {
+        adaptive_.fastPeriod = std::chrono::microseconds(0); // nothing to speed up
+    }
+}
+
+std::chrono::microseconds TelemetrySampler::currentPeriod() const {
+    return std::chrono::microseconds(currentPeriodUs_.load(std::memory_order_relaxed));
+}
+
+void TelemetrySampler::start() {
+    std::lock_guard<std::mutex> lock(stopMtx_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    if (!primed_) {
+        prime();
+    }
+    worker_ = std::thread(&TelemetrySampler::run, this);
+}
+
+// baseline for the first delta
+void TelemetrySampler::prime() {
+    readCpuTimes(files_, prevTimes_);
+    std::vector<MetricPlain> unused;
+    for (auto &collector : collectors_) {
+        collector->collect(Collector::Duration::zero(), unused);
+    }
+    prevCollect_ = std::chrono::steady_clock::now();
+    primed_ = true;
+}
+
+bool TelemetrySampler::sampleOnce() {
+    if (!primed_) {
+        prime();
+    }
+    return tick();
+}
+
+void TelemetrySampler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stopMtx_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    stopCv_.notify_all();
+    worker_.join();
+}
+
+void TelemetrySampler::run() {
+    auto next = std::chrono::steady_clock::now();
+    while (true) {
+        next += currentPeriod();
+        {
+            std::unique_lock<std::mutex> lock(stopMtx_);
+            if (stopCv_.wait_until(lock, next, [this] { return !running_; })) {
+                return;
+            }
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            next = now; // a slow tick must not cause a burst of catch-up ticks
+        }
+        tick();
+    }
+}
 
-bool TelemetrySampler::readCpuTimes(std::vector<CpuTimes> &times) {
-    times.clear();
+bool TelemetrySampler::tick() {
+    if (replaying_) {
+        ++replayCursor_;
+    }
 
-    std::ifstream file(PROC_STAT_PATH);
-    if (!file.is_open()) {
-        std::cerr << "[Telemetry] Failed to open " << PROC_STAT_PATH << "\n";
+    std::vector<CpuTimes> current;
+    if (!readCpuTimes(files_, current)) {
         return false;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.rfind("cpu", 0) != 0) {
-            continue;
+    // collectors and per-sensor metrics run on the base cadence even while fast
+    // ticks are going on; half a tick of slack keeps timer jitter from skipping a due run
+    auto now = std::chrono::steady_clock::now();
+    bool collectDue = now - prevCollect_ + currentPeriod() / 2 >= collectEvery_;
+
+    // a window shorter than a few jiffies would make every core read 0 or 100 %;
+    // keep the window open and repeat the last loads until it is long enough
+    if (current.size() != prevTimes_.size()) {
+        prevTimes_ = current;   // CPUs came or went: start a new window
+        lastLoads_.assign(current.size(), CoreLoadPlain{});
+    } else if ((replaying_ && replayCursor_ % recording_.frameCount() == 0) ||
+               countersRewound(prevTimes_, current)) {
+        // the replay looped back to frame 0 (or the kernel counters were reset):
+        // measuring from the old start would clamp to 0 and never close the window
+        prevTimes_ = std::move(current);
+    } else if (windowJiffies(prevTimes_, current) >= CPU_WINDOW_JIFFIES) {
+        lastLoads_ = computeLoads(prevTimes_, current);
+        prevTimes_ = std::move(current);
+    }
+
+    auto snapshot = std::make_shared<TelemetrySnapshotPlain>();
+    fillSnapshot(files_, lastLoads_, *snapshot, collectDue);
+
+    if (collectDue) {
+        for (auto &collector : collectors_) {
+            collector->collect(now - prevCollect_, snapshot->metrics);
+        }
+        prevCollect_ = now;
+    }
+
+    if (replaying_) {
+        snapshot->timestampMs = recording_.timestampMs(replayCursor_);
+    }
+
+    adapt(*snapshot, now);
+
+    std::atomic_store_explicit(&latest_, std::shared_ptr<const TelemetrySnapshotPlain>(snapshot),
+                               std::memory_order_release);
+    if (listener_) {
+        listener_(*snapshot);
+    }
+    return true;
+}
+
+void TelemetrySampler::adapt(const TelemetrySnapshotPlain &snapshot, std::chrono::steady_clock::time_point now) {
+    if (adaptive_.fastPeriod.count() == 0 || !adaptive_.isHot) {
+        return;
+    }
+
+    auto current = currentPeriod();
+    if (adaptive_.isHot(snapshot)) {
+        lastHot_ = now;
+        if (current != adaptive_.fastPeriod) {
+            std::cout << "[Telemetry] Sampling every " << adaptive_.fastPeriod.count() << " us\n";
         }
-        // Skip the aggregate "cpu " line; we only want cpu0, cpu1, ...
-        if (line.size() > 3 && std::isdigit(static_cast<unsigned char>(line[3]))) {
-            std::istringstream iss(line);
-            std::string label;
-            CpuTimes ct;
-            iss >> label
-                >> ct.user
-                >> ct.nice
-                >> ct.system
-                >> ct.idle
-                >> ct.iowait
-                >> ct.irq
-                >> ct.softirq
-                >> ct.steal;
-            times.push_back(ct);
+        current = adaptive_.fastPeriod;
+    } else if (current < period_ && now - lastHot_ >= adaptive_.hold) {
+        current = std::min<std::chrono::microseconds>(current * 2, period_);
+        if (current == period_) {
+            std::cout << "[Telemetry] Back to sampling every " << period_.count() << " us\n";
         }
     }
+    currentPeriodUs_.store(current.count(), std::memory_order_relaxed);
+}
+
+std::shared_ptr<const TelemetrySnapshotPlain> TelemetrySampler::latestShared() const {
+    return std::atomic_load_explicit(&latest_, std::memory_order_acquire);
+}
+
+bool TelemetrySampler::latest(TelemetrySnapshotPlain &outSnapshot) const {
+    auto snapshot = latestShared();
+    if (!snapshot) {
+        return false;
+    }
+    outSnapshot = *snapshot;
+    return true;
+}
+
+void TelemetrySampler::fillSnapshot(Files &files, std::vector<CoreLoadPlain> cores, TelemetrySnapshotPlain &outSnapshot,
+                                    bool sensorMetrics) {
+    // --- CPU loads ---
+    outSnapshot.coreLoads = buildCoreLoadsString(cores);
+    outSnapshot.cores = std::move(cores);
+
+    // --- RAM ---
+    outSnapshot.ramUsagePercent = readRamUsagePercent(files);
 
-    return !times.empty();
+    // --- Temperature ---
+    outSnapshot.temperatureC = readTemperatures(files, sensorMetrics ? &outSnapshot.metrics : nullptr);
+
+    outSnapshot.timestampMs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
 }
 
-std::vector<std::uint8_t> TelemetrySampler::computePerCoreLoads() {
-    std::vector<CpuTimes> t1, t2;
-    std::vector<std::uint8_t> result;
+// ---------------- CPU helpers ----------------
+
+bool TelemetrySampler::readCpuTimes(Files &files, std::vector<CpuTimes> &times) {
+    std::string_view text;
+    if (!files.stat.read(text)) {
+        times.clear();
+        return false;
+    }
+    return parseProcStat(text, times);
+}
 
-    if (!readCpuTimes(t1)) {
-        return result;
+std::uint64_t TelemetrySampler::windowJiffies(const std::vector<CpuTimes> &t1,
+                                              const std::vector<CpuTimes> &t2) {
+    const std::size_t cores = std::min(t1.size(), t2.size());
+    if (cores == 0) {
+        return 0;
     }
 
-    // small delay for measuring the delta
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    std::uint64_t least = UINT64_MAX;
+    for (std::size_t i = 0; i < cores; ++i) {
+        const CpuTimes &a = t1[i];
+        const CpuTimes &b = t2[i];
+        std::uint64_t before = a.user + a.nice + a.system + a.irq + a.softirq + a.idle + a.iowait + a.steal;
+        std::uint64_t after  = b.user + b.nice + b.system + b.irq + b.softirq + b.idle + b.iowait + b.steal;
+        least = std::min(least, counterDelta(before, after));
+    }
+    return least;
+}
 
-    if (!readCpuTimes(t2)) {
-        return result;
+bool TelemetrySampler::countersRewound(const std::vector<CpuTimes> &t1, const std::vector<CpuTimes> &t2) {
+    const std::size_t cores = std::min(t1.size(), t2.size());
+    for (std::size_t i = 0; i < cores; ++i) {
+        const CpuTimes &a = t1[i];
+        const CpuTimes &b = t2[i];
+        std::uint64_t before = a.user + a.nice + a.system + a.irq + a.softirq + a.idle + a.iowait + a.steal;
+        std::uint64_t after  = b.user + b.nice + b.system + b.irq + b.softirq + b.idle + b.iowait + b.steal;
+        if (after < before) {
+            return true;
+        }
     }
+    return false;
+}
 
+std::vector<CoreLoadPlain> TelemetrySampler::computeLoads(const std::vector<CpuTimes> &t1,
+                                                         const std::vector<CpuTimes> &t2) {
+    std::vector<CoreLoadPlain> result;
     const std::size_t cores = std::min(t1.size(), t2.size());
-    result.resize(cores, 0);
+    result.resize(cores);
 
     for (std::size_t i = 0; i < cores; ++i) {
         const CpuTimes &a = t1[i];
         const CpuTimes &b = t2[i];
 
-        std::uint64_t idle1    = a.idle + a.iowait;
-        std::uint64_t idle2    = b.idle + b.iowait;
-        std::uint64_t nonIdle1 = a.user + a.nice + a.system + a.irq + a.softirq + a.steal;
-        std::uint64_t nonIdle2 = b.user + b.nice + b.system + b.irq + b.softirq + b.steal;
-        std::uint64_t total1   = idle1 + nonIdle1;
-        std::uint64_t total2   = idle2 + nonIdle2;
-        std::uint64_t totald   = (total2 > total1) ? (total2 - total1) : 0;
-        std::uint64_t idled    = (idle2  > idle1)  ? (idle2  - idle1)  : 0;
-
-        std::uint8_t usage = 0;
-        if (totald > 0) {
-            double pct = static_cast<double>(totald - idled) * 100.0
-                       / static_cast<double>(totald);
-            if (pct < 0.0)   pct = 0.0;
-            if (pct > 100.0) pct = 100.0;
-            usage = static_cast<std::uint8_t>(pct + 0.5); // round
+        std::uint64_t user   = counterDelta(a.user + a.nice, b.user + b.nice);
+        std::uint64_t system = counterDelta(a.system + a.irq + a.softirq, b.system + b.irq + b.softirq);
+        std::uint64_t idle   = counterDelta(a.idle, b.idle);
+        std::uint64_t iowait = counterDelta(a.iowait, b.iowait);
+        std::uint64_t steal  = counterDelta(a.steal, b.steal);
+        std::uint64_t totald = user + system + idle + iowait + steal;
+        if (totald == 0) {
+            continue;
         }
 
-        result[i] = usage;
+        auto pct = [totald](std::uint64_t part) -> std::uint8_t {
+            double p = static_cast<double>(part) * 100.0 / static_cast<double>(totald);
+            if (p > 100.0) p = 100.0;
+            return static_cast<std::uint8_t>(p + 0.5); // round
+        };
+
+        CoreLoadPlain &load = result[i];
+        load.total  = pct(user + system + steal);
+        load.user   = pct(user);
+        load.system = pct(system);
+        load.iowait = pct(iowait);
+        load.steal  = pct(steal);
     }
 
     return result;
 }
 
-std::string TelemetrySampler::buildCoreLoadsString(const std::vector<std::uint8_t> &loads) {
-    if (loads.empty()) {
+std::string TelemetrySampler::buildCoreLoadsString(const std::vector<CoreLoadPlain> &cores) {
+    if (cores.empty()) {
         return "0";
     }
 
     std::uint64_t sum = 0;
-    for (auto v : loads) {
-        sum += v;
+    for (const auto &core : cores) {
+        sum += core.total;
     }
-    std::uint8_t avg = static_cast<std::uint8_t>(
-        std::min<std::uint64_t>(100, sum / loads.size())
-    );
-
-    // Return (avg + 1) * 5, capped at 100
-    int scaled = std::min(100, (static_cast<int>(avg) + 1) * 5);
-    return std::to_string(scaled);
+    // the mean of the per-core totals, the same CPU value the batch client derives
+    return std::to_string(std::min<std::uint64_t>(100, sum / cores.size()));
 }
 
 // ---------------- RAM helper ----------------
 
-std::uint32_t TelemetrySampler::readRamUsagePercent() {
-    std::ifstream file(PROC_MEMINFO);
-    if (!file.is_open()) {
-        std::cerr << "[Telemetry] Failed to open " << PROC_MEMINFO << "\n";
-        return 0;
-    }
-
-    std::string   line;
+std::uint32_t TelemetrySampler::readRamUsagePercent(Files &files) {
+    std::string_view text;
     std::uint64_t memTotal     = 0;
     std::uint64_t memAvailable = 0;
-
-    while (std::getline(file, line)) {
-        if (line.rfind("MemTotal:", 0) == 0) {
-            std::istringstream iss(line.substr(9));
-            iss >> memTotal;
-        } else if (line.rfind("MemAvailable:", 0) == 0) {
-            std::istringstream iss(line.substr(13));
-            iss >> memAvailable;
-        }
-        if (memTotal && memAvailable) {
-            break;
-        }
+    if (!files.meminfo.read(text) || !parseProcMeminfo(text, memTotal, memAvailable)) {
+        return 0;
     }
 
     if (memTotal == 0) {
@@ -169,19 +365,25 @@ std::uint32_t TelemetrySampler::readRamUsagePercent() {
 
 // ---------------- Temp helper ----------------
 
-std::uint16_t TelemetrySampler::readCpuTemperatureC() {
-    std::ifstream file(THERMAL_TEMP_PATH);
-    if (!file.is_open()) {
-        std::cerr << "[Telemetry] Failed to open " << THERMAL_TEMP_PATH << "\n";
+std::uint16_t TelemetrySampler::readTemperatures(Files &files, std::vector<MetricPlain> *metrics) {
+    ThermalSensors::Reading &reading = files.thermalReading;
+    if (!files.thermal.read(reading)) {
         return 0;
     }
 
-    long raw = 0;
-    file >> raw;
+    const auto &sensors = files.thermal.sensors();
+    for (size_t i = 0; metrics && i < sensors.size(); ++i) {
+        if (!std::isnan(reading.perSensorC[i])) {
+            metrics->push_back(MetricPlain{"TEMP", sensors[i].label, reading.perSensorC[i]});
+        }
+    }
+    if (metrics && sensors.size() > 1) {
+        metrics->push_back(MetricPlain{"TEMP", "avg", reading.avgC});
+    }
 
-    // Usually in millidegrees C (e.g. 55000 -> 55°C)
-    if (raw < 0) raw = 0;
-    long c = raw / 1000;
+    // the scalar field keeps its meaning of "CPU temperature": the hottest CPU
+    // sensor, so a hot NVMe drive or battery does not show up as the CPU
+    float c = reading.cpuC;
     if (c < 0)     c = 0;
     if (c > 65535) c = 65535;
 
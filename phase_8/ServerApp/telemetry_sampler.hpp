@@ -1,35 +1,154 @@
 #pragma once
 
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "collectors.hpp"
+#include "proc_reader.hpp"
+#include "recording.hpp"
+#include "thermal_sensors.hpp"
+
+// percent of one core's time over the last interval
+struct CoreLoadPlain {
+    uint8_t total   = 0;  // everything but idle + iowait
+    uint8_t user    = 0;  // user + nice
+    uint8_t system  = 0;  // system + irq + softirq
+    uint8_t iowait  = 0;
+    uint8_t steal   = 0;
+};
+
 struct TelemetrySnapshotPlain {
     std::string  coreLoads;  
-    uint16_t     temperatureC;      
+    uint16_t     temperatureC;          // hottest CPU sensor; per-sensor values are "TEMP" metrics
     uint32_t     ramUsagePercent;  
-        
-};
-
-struct CpuTimes {
-    uint64_t user    = 0;
-    uint64_t nice    = 0;
-    uint64_t system  = 0;
-    uint64_t idle    = 0;
-    uint64_t iowait  = 0;
-    uint64_t irq     = 0;
-    uint64_t softirq = 0;
-    uint64_t steal   = 0;
+    std::vector<CoreLoadPlain> cores;   // per core, for the typed batch broadcast
+    uint64_t     timestampMs = 0;       // wall clock at the end of sampling
+    std::vector<MetricPlain> metrics;   // from the registered collectors, in registration order
 };
 
+// Samples on its own thread every period, computing CPU deltas against the
+// previous tick instead of sleeping between two reads. The newest snapshot is
+// published by swapping an immutable shared_ptr, so readers never wait on the
+// sampler and never see a half-written snapshot.
+//
+// All files are opened below `root` ("/" in production). With a replayDir the
+// sampler instead discovers sensors under <replayDir>/root and serves
+// /proc/stat, /proc/meminfo and the thermal files from the recording, one
+// frame per tick, looping at the end.
+//
+// Periods are in microseconds, so sub-10 ms sampling works; collectors keep
+// running at no less than COLLECTOR_PERIOD_MIN, where their deltas still mean
+// something, and a fast tick costs only /proc/stat, meminfo and the sensors.
+// /proc/stat counts in 10 ms jiffies, so CPU loads are computed over a window
+// of at least CPU_WINDOW_JIFFIES per core; ticks inside a window repeat the
+// last loads while RAM and temperature are still read fresh. A replay that
+// loops back to its first frame starts a new window.
 class TelemetrySampler {
 public:
-    static bool sample(TelemetrySnapshotPlain &outSnapshot);
+    using Listener = std::function<void(const TelemetrySnapshotPlain &)>;
+
+    // Adaptive sampling: while isHot() holds for the newest snapshot the sampler
+    // ticks every fastPeriod; once it has been calm for `hold`, the period
+    // doubles every tick until it is back at the base period.
+    struct AdaptiveOptions {
+        std::chrono::microseconds fastPeriod{0};          // 0 = fixed period
+        std::chrono::milliseconds hold{2000};
+        std::function<bool(const TelemetrySnapshotPlain &)> isHot;
+    };
+
+    static constexpr std::chrono::milliseconds COLLECTOR_PERIOD_MIN{100};
+    // 10 jiffies (100 ms at USER_HZ 100) give loads in 10 % steps
+    static constexpr std::uint64_t CPU_WINDOW_JIFFIES = 10;
+
+    explicit TelemetrySampler(std::chrono::microseconds period = std::chrono::milliseconds(200),
+                              const std::string &root = "/",
+                              const std::string &replayDir = "");
+    ~TelemetrySampler();
+
+    TelemetrySampler(const TelemetrySampler &) = delete;
+    TelemetrySampler &operator=(const TelemetrySampler &) = delete;
+
+    // called on the sampler thread after every published snapshot
+    void setListener(Listener listener);
+    // collectors run on the sampler thread each tick; add them before start()
+    void addCollector(std::unique_ptr<Collector> collector);
+    // before start()
+    void setAdaptive(AdaptiveOptions options);
+    // the interval the sampler is currently ticking at; any thread
+    std::chrono::microseconds currentPeriod() const;
+    void start();
+    void stop();
+
+    // one tick on the caller's thread, for replay runs and benchmarks; not while started
+    bool sampleOnce();
+
+    bool isReplaying() const { return replaying_; }
+    // root the files are opened under, always ending in '/'
+    const std::string &root() const { return root_; }
+
+    // copies the newest snapshot; false until the first tick has completed
+    bool latest(TelemetrySnapshotPlain &outSnapshot) const;
+    std::shared_ptr<const TelemetrySnapshotPlain> latestShared() const;
 
 private:
-    static bool readCpuTimes(std::vector<CpuTimes> &times);
-    static std::vector<std::uint8_t> computePerCoreLoads();
-    static std::string buildCoreLoadsString(const std::vector<std::uint8_t> &loads);
-    static std::uint32_t readRamUsagePercent();
-    static std::uint16_t readCpuTemperatureC();
+    // kept open for the sampler's lifetime and re-read with pread every tick
+    struct Files {
+        explicit Files(const std::string &root);
+        ProcFile stat;
+        ProcFile meminfo;
+        ThermalSensors thermal;
+        ThermalSensors::Reading thermalReading;
+    };
+
+    void run();
+    bool tick();
+    void adapt(const TelemetrySnapshotPlain &snapshot, std::chrono::steady_clock::time_point now);
+    void prime();
+    void attachReplay(ProcFile &file);
+
+    Recording recording_;
+    bool replaying_ = false;
+    size_t replayCursor_ = 0;
+    std::string root_;
+    Files files_;
+    bool primed_ = false;
+
+    std::chrono::microseconds period_;
+    std::chrono::microseconds collectEvery_;
+    AdaptiveOptions adaptive_;
+    std::atomic<int64_t> currentPeriodUs_{0};
+    std::chrono::steady_clock::time_point lastHot_;
+    Listener listener_;
+    std::vector<CpuTimes> prevTimes_;               // start of the current CPU window
+    std::vector<CoreLoadPlain> lastLoads_;          // loads of the last completed window
+    std::vector<std::unique_ptr<Collector>> collectors_;
+    std::chrono::steady_clock::time_point prevCollect_;
+    std::shared_ptr<const TelemetrySnapshotPlain> latest_;  // accessed with std::atomic_load/store
+
+    std::thread worker_;
+    std::mutex stopMtx_;
+    std::condition_variable stopCv_;
+    bool running_ = false;
+
+    static bool readCpuTimes(Files &files, std::vector<CpuTimes> &times);
+    // jiffies the least advanced core has counted between t1 and t2
+    static std::uint64_t windowJiffies(const std::vector<CpuTimes> &t1, const std::vector<CpuTimes> &t2);
+    // true if any core's total went backwards between t1 and t2
+    static bool countersRewound(const std::vector<CpuTimes> &t1, const std::vector<CpuTimes> &t2);
+    static std::vector<CoreLoadPlain> computeLoads(const std::vector<CpuTimes> &t1,
+                                                   const std::vector<CpuTimes> &t2);
+    static void fillSnapshot(Files &files, std::vector<CoreLoadPlain> cores, TelemetrySnapshotPlain &outSnapshot,
+                             bool sensorMetrics);
+    static std::string buildCoreLoadsString(const std::vector<CoreLoadPlain> &cores);
+    static std::uint32_t readRamUsagePercent(Files &files);
+    // per-sensor values are appended to metrics unless it is null
+    static std::uint16_t readTemperatures(Files &files, std::vector<MetricPlain> *metrics);
 };
\ No newline at end of file
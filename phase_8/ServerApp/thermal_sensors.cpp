@@ -0,0 +1,200 @@
+// thermal_sensors.cpp
+#include "thermal_sensors.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+// Directory entries starting with prefix, ordered by their numeric suffix
+// (thermal_zone2 before thermal_zone10).
+static std::vector<std::string> listNumbered(const std::string &dir, const char *prefix) {
+    std::vector<std::string> names;
+    DIR *d = ::opendir(dir.c_str());
+    if (!d) {
+        return names;
+    }
+    size_t prefixLen = strlen(prefix);
+    while (dirent *entry = ::readdir(d)) {
+        if (strncmp(entry->d_name, prefix, prefixLen) == 0) {
+            names.emplace_back(entry->d_name);
+        }
+    }
+    ::closedir(d);
+
+    std::sort(names.begin(), names.end(), [prefixLen](const std::string &a, const std::string &b) {
+        return std::atol(a.c_str() + prefixLen) < std::atol(b.c_str() + prefixLen);
+    });
+    return names;
+}
+
+// Small sysfs attribute such as "type" or "name", trailing newline removed; empty if missing.
+static std::string readAttribute(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return std::string();
+    }
+    char buf[128];
+    ssize_t n = ::read(fd, buf, sizeof(buf));
+    ::close(fd);
+    if (n <= 0) {
+        return std::string();
+    }
+    std::string value(buf, static_cast<size_t>(n));
+    while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) {
+        value.pop_back();
+    }
+    return value;
+}
+
+// Zone types and hwmon chip names of CPU sensors. SoC zones are usually
+// named "cpu-thermal", "cpu0-thermal", "cpu_thermal"..., hence the prefix.
+static bool isCpuType(const std::string &type) {
+    static const char *const CPU_TYPES[] = {
+        "x86_pkg_temp", "coretemp", "k10temp", "zenpower", "soc_thermal", "soc-thermal",
+    };
+    for (const char *cpuType : CPU_TYPES) {
+        if (type == cpuType) {
+            return true;
+        }
+    }
+    return type.compare(0, 3, "cpu") == 0;
+}
+
+ThermalSensors::ThermalSensors(const std::string &sysfsRoot) {
+    discoverThermalZones(sysfsRoot + "/class/thermal");
+    discoverHwmon(sysfsRoot + "/class/hwmon");
+    markDuplicates();
+
+    if (sensors_.empty()) {
+        std::cerr << "[Telemetry] No thermal zone or hwmon sensor under " << sysfsRoot
+                  << ", temperature will read 0\n";
+    } else {
+        std::cout << "[Telemetry] " << sensors_.size() << " temperature sensor(s):";
+        for (const Sensor &sensor : sensors_) {
+            std::cout << " " << sensor.label;
+        }
+        std::cout << "\n";
+    }
+}
+
+void ThermalSensors::discoverThermalZones(const std::string &classDir) {
+    for (const std::string &zone : listNumbered(classDir, "thermal_zone")) {
+        std::string dir = classDir + "/" + zone;
+        std::string type = readAttribute(dir + "/type");
+        if (type.empty()) {
+            type = zone;
+        }
+        addSensor(type, type, dir + "/temp");
+    }
+}
+
+void ThermalSensors::discoverHwmon(const std::string &classDir) {
+    for (const std::string &hwmon : listNumbered(classDir, "hwmon")) {
+        std::string dir = classDir + "/" + hwmon;
+        std::string chip = readAttribute(dir + "/name");
+        if (chip.empty()) {
+            chip = hwmon;
+        }
+
+        // temp1_input, temp2_input, ... each with an optional temp<N>_label
+        for (const std::string &input : listNumbered(dir, "temp")) {
+            size_t suffix = input.find("_input");
+            if (suffix == std::string::npos || suffix + 6 != input.size()) {
+                continue;
+            }
+            std::string base = input.substr(0, suffix);
+            std::string label = readAttribute(dir + "/" + base + "_label");
+            addSensor(chip + "/" + (label.empty() ? base : label), chip, dir + "/" + input);
+        }
+    }
+}
+
+bool ThermalSensors::addSensor(std::string label, std::string type, const std::string &path) {
+    auto file = std::make_unique<ProcFile>(path);
+    std::string_view text;
+    long raw = 0;
+    // zones of powered-down devices fail to read; they are left out rather than reported as 0
+    if (!file->read(text) || !parseSignedValue(text, raw)) {
+        return false;
+    }
+    bool cpu = isCpuType(type);
+    sensors_.push_back(Sensor{std::move(label), std::move(type), cpu, false, std::move(file)});
+    return true;
+}
+
+// A thermal zone bound to a hwmon device shows up again as a hwmon chip named
+// after the zone type ('-' becomes '_'). x86_pkg_temp has no such twin but
+// reads the same package as coretemp's "Package id N". The zone is the copy
+// that gets dropped, since hwmon carries the per-core detail.
+void ThermalSensors::markDuplicates() {
+    bool corePackage = false;
+    for (const Sensor &sensor : sensors_) {
+        if (sensor.type == "coretemp" && sensor.label.find("/Package id") != std::string::npos) {
+            corePackage = true;
+        }
+    }
+
+    for (Sensor &zone : sensors_) {
+        if (zone.label != zone.type) {
+            continue;   // hwmon sensors are labelled "<chip>/..."
+        }
+        std::string chip = zone.type;
+        std::replace(chip.begin(), chip.end(), '-', '_');
+        for (const Sensor &other : sensors_) {
+            if (&other != &zone && other.label != other.type && other.type == chip) {
+                zone.duplicate = true;
+            }
+        }
+        if (zone.type == "x86_pkg_temp" && corePackage) {
+            zone.duplicate = true;
+        }
+    }
+}
+
+bool ThermalSensors::read(Reading &out) {
+    out.perSensorC.resize(sensors_.size());
+    out.maxC = 0.0f;
+    out.cpuC = 0.0f;
+    out.avgC = 0.0f;
+
+    size_t valid = 0;
+    size_t validCpu = 0;
+    size_t averaged = 0;
+    double sum = 0.0;
+    for (size_t i = 0; i < sensors_.size(); ++i) {
+        std::string_view text;
+        long raw = 0;
+        if (!sensors_[i].file->read(text) || !parseSignedValue(text, raw)) {
+            out.perSensorC[i] = std::nanf("");
+            continue;
+        }
+        // millidegrees C (e.g. 55000 -> 55°C)
+        float c = static_cast<float>(raw) / 1000.0f;
+        out.perSensorC[i] = c;
+        out.maxC = (valid == 0 || c > out.maxC) ? c : out.maxC;
+        ++valid;
+        if (sensors_[i].cpu) {
+            out.cpuC = (validCpu == 0 || c > out.cpuC) ? c : out.cpuC;
+            ++validCpu;
+        }
+        if (!sensors_[i].duplicate) {
+            sum += c;
+            ++averaged;
+        }
+    }
+
+    if (valid == 0) {
+        return false;
+    }
+    if (validCpu == 0) {
+        out.cpuC = out.maxC;
+    }
+    // only duplicates could be read: average those rather than report 0
+    out.avgC = averaged ? static_cast<float>(sum / static_cast<double>(averaged)) : out.maxC;
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proc_reader.hpp"
+
+// Every temperature sensor found under a sysfs root at construction:
+// /class/thermal/thermal_zone*/temp (labelled by the zone's type) and
+// /class/hwmon/hwmon*/temp*_input (labelled "<chip>/<label or tempN>").
+// The files stay open and are re-read with pread on each sample.
+// Sensors are classified at discovery: CPU sensors (x86_pkg_temp,
+// coretemp, k10temp, cpu-thermal...) feed the CPU temperature, and zones
+// that the kernel also exports through hwmon are marked as duplicates so
+// the same die is counted once in the average.
+class ThermalSensors {
+public:
+    struct Sensor {
+        std::string label;     // e.g. "x86_pkg_temp", "coretemp/Core 0"
+        std::string type;      // zone type or hwmon chip name
+        bool cpu = false;      // type names a CPU package/core sensor
+        bool duplicate = false; // zone also read through hwmon, left out of avgC
+        std::unique_ptr<ProcFile> file;
+    };
+
+    struct Reading {
+        float maxC = 0.0f;     // hottest sensor of any kind
+        float cpuC = 0.0f;     // hottest CPU sensor, maxC when there is none
+        float avgC = 0.0f;     // duplicates excluded
+        std::vector<float> perSensorC;   // same order as sensors(), NaN if a read failed
+    };
+
+    // sysfsRoot is normally "/sys"; tests can point it at a fake tree
+    explicit ThermalSensors(const std::string &sysfsRoot = "/sys");
+
+    const std::vector<Sensor> &sensors() const { return sensors_; }
+
+    // false when no sensor could be read
+    bool read(Reading &out);
+
+private:
+    void discoverThermalZones(const std::string &classDir);
+    void discoverHwmon(const std::string &classDir);
+    bool addSensor(std::string label, std::string type, const std::string &path);
+    void markDuplicates();
+
+    std::vector<Sensor> sensors_;
+};
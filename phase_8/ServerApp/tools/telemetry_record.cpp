@@ -0,0 +1,118 @@
+// telemetry_record.cpp
+// Captures what TelemetrySampler reads - /proc/stat, /proc/meminfo and every
+// discovered temperature sensor - into a recording directory that
+// `TELEMETRY_REPLAY=<dir> server` or sampler_replay_bench can replay.
+//
+//   telemetry_record <out_dir> [frames=300] [period_ms=200] [root=/]
+#include "../proc_reader.hpp"
+#include "../recording.hpp"
+#include "../thermal_sensors.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// copies root/relPath into outRoot/relPath; silently skips files that do not exist
+static void copyIntoRoot(const std::string &root, const std::string &outRoot, const std::string &relPath) {
+    std::ifstream in(root + relPath, std::ios::binary);
+    if (!in) {
+        return;
+    }
+    fs::path target = fs::path(outRoot) / relPath;
+    fs::create_directories(target.parent_path());
+    std::ofstream out(target, std::ios::binary);
+    out << in.rdbuf();
+}
+
+static void writeIntoRoot(const std::string &outRoot, const std::string &relPath, std::string_view contents) {
+    fs::path target = fs::path(outRoot) / relPath;
+    fs::create_directories(target.parent_path());
+    std::ofstream out(target, std::ios::binary);
+    out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: telemetry_record <out_dir> [frames=300] [period_ms=200] [root=/]\n";
+        return 1;
+    }
+    const std::string outDir = argv[1];
+    const long frames = (argc > 2) ? std::atol(argv[2]) : 300;
+    const long periodMs = (argc > 3) ? std::atol(argv[3]) : 200;
+    std::string root = (argc > 4) ? argv[4] : "/";
+    if (root.back() != '/') {
+        root += '/';
+    }
+    const std::string outRoot = outDir + "/root/";
+
+    // the same discovery the sampler does, so the recording holds exactly its files
+    ThermalSensors thermal(root + "sys");
+    std::vector<std::string> relPaths = {"proc/stat", "proc/meminfo"};
+    for (const auto &sensor : thermal.sensors()) {
+        const std::string relPath = sensor.file->path().substr(root.size());
+        relPaths.push_back(relPath);
+
+        // attributes ThermalSensors reads once at startup
+        fs::path dir = fs::path(relPath).parent_path();
+        copyIntoRoot(root, outRoot, (dir / "type").string());
+        copyIntoRoot(root, outRoot, (dir / "name").string());
+        std::string name = fs::path(relPath).filename().string();
+        size_t input = name.rfind("_input");
+        if (input != std::string::npos) {
+            copyIntoRoot(root, outRoot, (dir / (name.substr(0, input) + "_label")).string());
+        }
+    }
+
+    std::vector<std::unique_ptr<ProcFile>> files;
+    for (const std::string &relPath : relPaths) {
+        files.push_back(std::make_unique<ProcFile>(root + relPath));
+    }
+
+    fs::create_directories(outDir);
+    std::ofstream out(outDir + "/frames", std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[Telemetry] Cannot write " << outDir << "/frames\n";
+        return 1;
+    }
+
+    std::cout << "[Telemetry] Recording " << frames << " frame(s) of " << relPaths.size()
+              << " file(s) every " << periodMs << " ms into " << outDir << "\n";
+
+    Recording::FileContents contents;
+    auto next = std::chrono::steady_clock::now();
+    for (long frame = 0; frame < frames; ++frame) {
+        contents.clear();
+        for (size_t i = 0; i < files.size(); ++i) {
+            std::string_view text;
+            if (files[i]->read(text)) {
+                contents.emplace_back(relPaths[i], text);
+            }
+        }
+
+        auto timestampMs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        Recording::writeFrame(out, timestampMs, contents);
+
+        // the first frame doubles as the root copy the replaying sampler opens
+        if (frame == 0) {
+            for (const auto &file : contents) {
+                writeIntoRoot(outRoot, file.first, file.second);
+            }
+        }
+
+        next += std::chrono::milliseconds(periodMs);
+        std::this_thread::sleep_until(next);
+    }
+
+    std::cout << "[Telemetry] Done\n";
+    return 0;
+}
@@ -0,0 +1,196 @@
+// binary_sink_bench.cpp
+// Writes the same synthetic telemetry through filesink-style text lines and
+// binarysink, then compares file size and the cost of reading it back:
+// regex-parsing the text log against BinaryTelemetryReader::scan. Also cuts
+// the footer off a copy of the binary file, as a crash would, and checks the
+// reader still recovers every complete block. Last, it checks that dedup
+// summaries keep their repeat count and that more names than a dictionary
+// holds keep their own labels.
+//
+//   binary_sink_bench [rows] [dir]
+#include "binaryreader.hpp"
+#include "binarysink.hpp"
+#include "logfilter.hpp"
+#include "logmessage.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const char *CONTEXTS[] = {"CPU", "RAM", "TEMP"};
+
+static std::string timeText(std::time_t t) {
+    char buf[32];
+    std::tm tm{};
+    localtime_r(&t, &tm);
+    std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+    return buf;
+}
+
+static uint64_t fileSize(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+}
+
+template <typename Fn>
+static double msFor(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    const size_t rows = (argc > 1) ? std::stoul(argv[1]) : 300000;
+    const std::string dir = (argc > 2) ? argv[2] : ".";
+    const std::string textPath = dir + "/bench_telemetry.log";
+    const std::string binPath = dir + "/bench_telemetry.tlm";
+    const std::string cutPath = dir + "/bench_telemetry_cut.tlm";
+
+    // four samples per second, one row per context, slowly drifting values
+    const std::time_t start = 1700000000;
+    {
+        std::ofstream text(textPath);
+        binarysink bin(binPath);
+        for (size_t i = 0; i < rows; ++i) {
+            const char *context = CONTEXTS[i % 3];
+            float value = std::round((50.0f + 30.0f * std::sin(i * 0.001f) + (i % 7)) * 10.0f) / 10.0f;
+            const char *severity = value > 80.0f ? "WARNING" : "INFO";
+
+            std::ostringstream description;
+            description << context << " usage: " << value << "%";
+            logmessage msg("TelemetryApp", timeText(start + static_cast<std::time_t>(i / 12)), context, severity,
+                           description.str());
+            msg.setValue(value);
+
+            text << msg << '\n';
+            bin.write(msg);
+        }
+    }
+
+    const uint64_t textBytes = fileSize(textPath);
+    const uint64_t binBytes = fileSize(binPath);
+    std::cout << "rows            " << rows << "\n"
+              << "text bytes      " << textBytes << "\n"
+              << "binary bytes    " << binBytes << " (" << static_cast<double>(textBytes) / binBytes << "x smaller)\n";
+
+    // full read: every CPU value
+    size_t textCount = 0;
+    double textMs = msFor([&] {
+        std::ifstream in(textPath);
+        std::regex cpu(R"(\((CPU)\): CPU usage: ([0-9.]+)%)");
+        std::string line;
+        std::smatch m;
+        double sum = 0;
+        while (std::getline(in, line)) {
+            if (std::regex_search(line, m, cpu)) {
+                sum += std::stod(m[2]);
+                ++textCount;
+            }
+        }
+        (void)sum;
+    });
+
+    size_t binCount = 0;
+    double binMs = msFor([&] {
+        BinaryTelemetryReader reader(binPath);
+        double sum = 0;
+        reader.scan(INT64_MIN, INT64_MAX, [&](const TelemetryRecord &r) {
+            if (r.context == "CPU") {
+                sum += r.value;
+                ++binCount;
+            }
+        });
+        (void)sum;
+    });
+
+    std::cout << "text regex scan " << textMs << " ms, " << textCount << " CPU rows\n"
+              << "binary scan     " << binMs << " ms, " << binCount << " CPU rows (" << textMs / binMs << "x faster)\n";
+
+    // a 100 second window only touches the blocks that overlap it
+    BinaryTelemetryReader reader(binPath);
+    const int64_t fromMs = (static_cast<int64_t>(start) + 1000) * 1000;
+    size_t rangeCount = 0;
+    double rangeMs = msFor([&] {
+        rangeCount = reader.scan(fromMs, fromMs + 100 * 1000, [](const TelemetryRecord &) {});
+    });
+    std::cout << "100 s range     " << rangeMs << " ms, " << rangeCount << " rows of " << reader.getBlockCount()
+              << " blocks\n";
+
+    // drop the footer and half of the last block, as a killed writer would leave it
+    int failures = 0;
+    {
+        std::ifstream in(binPath, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream(cutPath, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 4096));
+    }
+    BinaryTelemetryReader cut(cutPath);
+    const uint64_t recovered = cut.getRecordCount();
+    std::cout << "without footer  " << cut.getBlockCount() << " blocks, " << recovered << " rows readable\n";
+    if (!cut.isOpen() || recovered == 0 || recovered >= rows ||
+        cut.scan(INT64_MIN, INT64_MAX, [](const TelemetryRecord &) {}) != recovered) {
+        std::cerr << "truncated file not recovered\n";
+        ++failures;
+    }
+    if (binCount != textCount || reader.getRecordCount() != rows) {
+        std::cerr << "binary and text disagree\n";
+        ++failures;
+    }
+
+    // a constant value folded by the dedup stage, then 300 distinct names (more than a dictionary holds)
+    const std::string mixedPath = dir + "/bench_telemetry_mixed.tlm";
+    {
+        LogFilterOptions options;
+        options.dedup = true;
+        LogFilter filter(options);
+        std::vector<logmessage> out;
+        for (int i = 0; i < 50; ++i) {
+            logmessage msg("TelemetryApp", timeText(start + i), "RAM", "INFO", "RAM usage: 42%");
+            msg.setValue(42.0f);
+            filter.process(msg, out);
+        }
+        filter.drain(out);
+        for (int i = 0; i < 300; ++i) {
+            logmessage msg("agent" + std::to_string(i), timeText(start + 60), "CPU", "INFO", "CPU usage: 1%");
+            msg.setValue(static_cast<float>(i));
+            out.push_back(msg);
+        }
+        binarysink bin(mixedPath);
+        for (const auto &msg : out) {
+            bin.write(msg);
+        }
+    }
+    uint64_t repeated = 0;
+    std::set<std::string> names;
+    bool labelsMatch = true;
+    BinaryTelemetryReader mixed(mixedPath);
+    mixed.scan(INT64_MIN, INT64_MAX, [&](const TelemetryRecord &r) {
+        repeated += r.repeats;
+        if (r.context == "CPU") {
+            names.emplace(r.name);
+            labelsMatch &= (r.name == "agent" + std::to_string(static_cast<int>(r.value)));
+        }
+    });
+    std::cout << "dedup + names   " << repeated << " repeats kept, " << names.size() << " names in "
+              << mixed.getBlockCount() << " blocks\n";
+    if (repeated != 49 || names.size() != 300 || !labelsMatch) {
+        std::cerr << "dedup summaries or dictionary overflow mishandled\n";
+        ++failures;
+    }
+
+    std::remove(textPath.c_str());
+    std::remove(binPath.c_str());
+    std::remove(cutPath.c_str());
+    std::remove(mixedPath.c_str());
+    return failures == 0 ? 0 : 1;
+}
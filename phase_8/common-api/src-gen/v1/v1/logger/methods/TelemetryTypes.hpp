@@ -24,6 +24,7 @@
 #include <CommonAPI/Types.hpp>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #if defined (HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE)
 #undef COMMONAPI_INTERNAL_COMPILATION
@@ -64,6 +65,107 @@ struct TelemetryTypes {
         }
     
     };
+    struct CoreLoad : CommonAPI::Struct< uint8_t, uint8_t, uint8_t, uint8_t, uint8_t> {
+    
+        CoreLoad()
+        {
+            std::get< 0>(values_) = 0u;
+            std::get< 1>(values_) = 0u;
+            std::get< 2>(values_) = 0u;
+            std::get< 3>(values_) = 0u;
+            std::get< 4>(values_) = 0u;
+        }
+        CoreLoad(const uint8_t &_total, const uint8_t &_user, const uint8_t &_system, const uint8_t &_iowait, const uint8_t &_steal)
+        {
+            std::get< 0>(values_) = _total;
+            std::get< 1>(values_) = _user;
+            std::get< 2>(values_) = _system;
+            std::get< 3>(values_) = _iowait;
+            std::get< 4>(values_) = _steal;
+        }
+        inline const uint8_t &getTotal() const { return std::get< 0>(values_); }
+        inline void setTotal(const uint8_t &_value) { std::get< 0>(values_) = _value; }
+        inline const uint8_t &getUser() const { return std::get< 1>(values_); }
+        inline void setUser(const uint8_t &_value) { std::get< 1>(values_) = _value; }
+        inline const uint8_t &getSystem() const { return std::get< 2>(values_); }
+        inline void setSystem(const uint8_t &_value) { std::get< 2>(values_) = _value; }
+        inline const uint8_t &getIowait() const { return std::get< 3>(values_); }
+        inline void setIowait(const uint8_t &_value) { std::get< 3>(values_) = _value; }
+        inline const uint8_t &getSteal() const { return std::get< 4>(values_); }
+        inline void setSteal(const uint8_t &_value) { std::get< 4>(values_) = _value; }
+        inline bool operator==(const CoreLoad& _other) const {
+        return (getTotal() == _other.getTotal() && getUser() == _other.getUser() && getSystem() == _other.getSystem() && getIowait() == _other.getIowait() && getSteal() == _other.getSteal());
+        }
+        inline bool operator!=(const CoreLoad &_other) const {
+            return !((*this) == _other);
+        }
+    
+    };
+    struct Metric : CommonAPI::Struct< std::string, std::string, float> {
+    
+        Metric()
+        {
+            std::get< 0>(values_) = "";
+            std::get< 1>(values_) = "";
+            std::get< 2>(values_) = 0.0f;
+        }
+        Metric(const std::string &_source, const std::string &_label, const float &_value)
+        {
+            std::get< 0>(values_) = _source;
+            std::get< 1>(values_) = _label;
+            std::get< 2>(values_) = _value;
+        }
+        inline const std::string &getSource() const { return std::get< 0>(values_); }
+        inline void setSource(const std::string &_value) { std::get< 0>(values_) = _value; }
+        inline const std::string &getLabel() const { return std::get< 1>(values_); }
+        inline void setLabel(const std::string &_value) { std::get< 1>(values_) = _value; }
+        inline const float &getValue() const { return std::get< 2>(values_); }
+        inline void setValue(const float &_value) { std::get< 2>(values_) = _value; }
+        inline bool operator==(const Metric& _other) const {
+        return (getSource() == _other.getSource() && getLabel() == _other.getLabel() && getValue() == _other.getValue());
+        }
+        inline bool operator!=(const Metric &_other) const {
+            return !((*this) == _other);
+        }
+    
+    };
+    struct TelemetrySample : CommonAPI::Struct< uint64_t, std::vector< TelemetryTypes::CoreLoad >, uint32_t, uint16_t, std::vector< TelemetryTypes::Metric >> {
+    
+        TelemetrySample()
+        {
+            std::get< 0>(values_) = 0ull;
+            std::get< 1>(values_) = std::vector< TelemetryTypes::CoreLoad >();
+            std::get< 2>(values_) = 0ul;
+            std::get< 3>(values_) = 0u;
+            std::get< 4>(values_) = std::vector< TelemetryTypes::Metric >();
+        }
+        TelemetrySample(const uint64_t &_timestampMs, const std::vector< TelemetryTypes::CoreLoad > &_coreLoads, const uint32_t &_ramUsagePercentage, const uint16_t &_temperatureC, const std::vector< TelemetryTypes::Metric > &_metrics)
+        {
+            std::get< 0>(values_) = _timestampMs;
+            std::get< 1>(values_) = _coreLoads;
+            std::get< 2>(values_) = _ramUsagePercentage;
+            std::get< 3>(values_) = _temperatureC;
+            std::get< 4>(values_) = _metrics;
+        }
+        inline const uint64_t &getTimestampMs() const { return std::get< 0>(values_); }
+        inline void setTimestampMs(const uint64_t &_value) { std::get< 0>(values_) = _value; }
+        inline const std::vector< TelemetryTypes::CoreLoad > &getCoreLoads() const { return std::get< 1>(values_); }
+        inline void setCoreLoads(const std::vector< TelemetryTypes::CoreLoad > &_value) { std::get< 1>(values_) = _value; }
+        inline const uint32_t &getRamUsagePercentage() const { return std::get< 2>(values_); }
+        inline void setRamUsagePercentage(const uint32_t &_value) { std::get< 2>(values_) = _value; }
+        inline const uint16_t &getTemperatureC() const { return std::get< 3>(values_); }
+        inline void setTemperatureC(const uint16_t &_value) { std::get< 3>(values_) = _value; }
+        inline const std::vector< TelemetryTypes::Metric > &getMetrics() const { return std::get< 4>(values_); }
+        inline void setMetrics(const std::vector< TelemetryTypes::Metric > &_value) { std::get< 4>(values_) = _value; }
+        inline bool operator==(const TelemetrySample& _other) const {
+        return (getTimestampMs() == _other.getTimestampMs() && getCoreLoads() == _other.getCoreLoads() && getRamUsagePercentage() == _other.getRamUsagePercentage() && getTemperatureC() == _other.getTemperatureC() && getMetrics() == _other.getMetrics());
+        }
+        inline bool operator!=(const TelemetrySample &_other) const {
+            return !((*this) == _other);
+        }
+    
+    };
+    typedef std::vector< TelemetryTypes::TelemetrySample > TelemetrySampleBatch;
 
 
 static inline const char* getTypeCollectionName() {
@@ -35,6 +35,36 @@ typedef CommonAPI::SomeIP::StructDeployment<
     CommonAPI::SomeIP::IntegerDeployment<uint32_t>
 > TelemetrySnapshotDeployment_t;
 
+typedef CommonAPI::SomeIP::StructDeployment<
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint8_t>
+> CoreLoadDeployment_t;
+
+typedef CommonAPI::SomeIP::StructDeployment<
+    CommonAPI::SomeIP::StringDeployment,
+    CommonAPI::SomeIP::StringDeployment,
+    CommonAPI::EmptyDeployment
+> MetricDeployment_t;
+
+typedef CommonAPI::SomeIP::StructDeployment<
+    CommonAPI::SomeIP::IntegerDeployment<uint64_t>,
+    CommonAPI::SomeIP::ArrayDeployment<
+        CoreLoadDeployment_t
+    >,
+    CommonAPI::SomeIP::IntegerDeployment<uint32_t>,
+    CommonAPI::SomeIP::IntegerDeployment<uint16_t>,
+    CommonAPI::SomeIP::ArrayDeployment<
+        MetricDeployment_t
+    >
+> TelemetrySampleDeployment_t;
+
+typedef CommonAPI::SomeIP::ArrayDeployment<
+    TelemetrySampleDeployment_t
+> TelemetrySampleBatchDeployment_t;
+
 
 // typecollection-specific deployments
 
@@ -91,6 +91,19 @@ public:
      */
     virtual std::future<CommonAPI::CallStatus> requestDataAsync(RequestDataAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr);
 
+    /**
+     * Returns the wrapper class that provides access to the broadcast telemetryUpdate.
+     */
+    virtual TelemetryUpdateEvent& getTelemetryUpdateEvent() {
+        return delegate_->getTelemetryUpdateEvent();
+    }
+    /**
+     * Returns the wrapper class that provides access to the broadcast telemetryBatch.
+     */
+    virtual TelemetryBatchEvent& getTelemetryBatchEvent() {
+        return delegate_->getTelemetryBatchEvent();
+    }
+
 
 
  private:
@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 
+#include <CommonAPI/Event.hpp>
 #include <CommonAPI/Proxy.hpp>
 #include <functional>
 #include <future>
@@ -45,12 +46,21 @@ namespace methods {
 class loggingProxyBase
     : virtual public CommonAPI::Proxy {
 public:
+    typedef CommonAPI::Event<
+        TelemetryTypes::TelemetrySnapshot
+    > TelemetryUpdateEvent;
+    typedef CommonAPI::Event<
+        TelemetryTypes::TelemetrySampleBatch
+    > TelemetryBatchEvent;
 
     typedef std::function<void(const CommonAPI::CallStatus&, const TelemetryTypes::TelemetrySnapshot&)> RequestDataAsyncCallback;
 
     virtual void requestData(CommonAPI::CallStatus &_internalCallStatus, TelemetryTypes::TelemetrySnapshot &_data, const CommonAPI::CallInfo *_info = nullptr) = 0;
     virtual std::future<CommonAPI::CallStatus> requestDataAsync(RequestDataAsyncCallback _callback = nullptr, const CommonAPI::CallInfo *_info = nullptr) = 0;
 
+    virtual TelemetryUpdateEvent& getTelemetryUpdateEvent() = 0;
+    virtual TelemetryBatchEvent& getTelemetryBatchEvent() = 0;
+
     virtual std::future<void> getCompletionFuture() = 0;
 };
 
@@ -48,13 +48,22 @@ INITIALIZER(registerloggingSomeIPProxy) {
 loggingSomeIPProxy::loggingSomeIPProxy(
     const CommonAPI::SomeIP::Address &_address,
     const std::shared_ptr<CommonAPI::SomeIP::ProxyConnection> &_connection)
-        : CommonAPI::SomeIP::Proxy(_address, _connection)
+        : CommonAPI::SomeIP::Proxy(_address, _connection),
+          telemetryUpdate_(*this, 0x1, CommonAPI::SomeIP::event_id_t(0x8001), CommonAPI::SomeIP::event_type_e::ET_EVENT , CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE, false, std::make_tuple(static_cast< ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySnapshotDeployment_t* >(nullptr))),
+          telemetryBatch_(*this, 0x2, CommonAPI::SomeIP::event_id_t(0x8002), CommonAPI::SomeIP::event_type_e::ET_EVENT , CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE, false, std::make_tuple(static_cast< ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySampleBatchDeployment_t* >(nullptr)))
 {
 }
 
 loggingSomeIPProxy::~loggingSomeIPProxy() {
 }
 
+loggingSomeIPProxy::TelemetryUpdateEvent& loggingSomeIPProxy::getTelemetryUpdateEvent() {
+    return telemetryUpdate_;
+}
+
+loggingSomeIPProxy::TelemetryBatchEvent& loggingSomeIPProxy::getTelemetryBatchEvent() {
+    return telemetryBatch_;
+}
 
 
 void loggingSomeIPProxy::requestData(CommonAPI::CallStatus &_internalCallStatus, TelemetryTypes::TelemetrySnapshot &_data, const CommonAPI::CallInfo *_info) {
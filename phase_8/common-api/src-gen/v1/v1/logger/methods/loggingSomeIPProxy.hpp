@@ -21,6 +21,7 @@
 #include <CommonAPI/SomeIP/Factory.hpp>
 #include <CommonAPI/SomeIP/Proxy.hpp>
 #include <CommonAPI/SomeIP/Types.hpp>
+#include <CommonAPI/SomeIP/Event.hpp>
 
 #if defined (HAS_DEFINED_COMMONAPI_INTERNAL_COMPILATION_HERE)
 #undef COMMONAPI_INTERNAL_COMPILATION
@@ -56,6 +57,10 @@ public:
 
     virtual ~loggingSomeIPProxy();
 
+    virtual TelemetryUpdateEvent& getTelemetryUpdateEvent();
+
+    virtual TelemetryBatchEvent& getTelemetryBatchEvent();
+
     virtual void requestData(CommonAPI::CallStatus &_internalCallStatus, TelemetryTypes::TelemetrySnapshot &_data, const CommonAPI::CallInfo *_info);
 
     virtual std::future<CommonAPI::CallStatus> requestDataAsync(RequestDataAsyncCallback _callback, const CommonAPI::CallInfo *_info);
@@ -66,6 +71,8 @@ public:
 
 private:
 
+    CommonAPI::SomeIP::Event<TelemetryUpdateEvent, CommonAPI::Deployable< TelemetryTypes::TelemetrySnapshot, ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySnapshotDeployment_t >> telemetryUpdate_;
+    CommonAPI::SomeIP::Event<TelemetryBatchEvent, CommonAPI::Deployable< TelemetryTypes::TelemetrySampleBatch, ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySampleBatchDeployment_t >> telemetryBatch_;
 };
 
 } // namespace methods
@@ -49,6 +49,10 @@ public:
         loggingSomeIPStubAdapterHelper::deinit();
     }
 
+    void fireTelemetryUpdateEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &_data);
+
+    void fireTelemetryBatchEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch &_samples);
+
     void deactivateManagedInstances() {}
     
     CommonAPI::SomeIP::GetAttributeStubDispatcher<
@@ -84,6 +88,16 @@ public:
     {
         loggingSomeIPStubAdapterHelper::addStubDispatcher( { CommonAPI::SomeIP::method_id_t(0x1) }, &requestDataStubDispatcher );
         // Provided events/fields
+        {
+            std::set<CommonAPI::SomeIP::eventgroup_id_t> itsEventGroups;
+            itsEventGroups.insert(CommonAPI::SomeIP::eventgroup_id_t(CommonAPI::SomeIP::eventgroup_id_t(0x1)));
+            CommonAPI::SomeIP::StubAdapter::registerEvent(CommonAPI::SomeIP::event_id_t(0x8001), itsEventGroups, CommonAPI::SomeIP::event_type_e::ET_EVENT, CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE);
+        }
+        {
+            std::set<CommonAPI::SomeIP::eventgroup_id_t> itsEventGroups;
+            itsEventGroups.insert(CommonAPI::SomeIP::eventgroup_id_t(CommonAPI::SomeIP::eventgroup_id_t(0x2)));
+            CommonAPI::SomeIP::StubAdapter::registerEvent(CommonAPI::SomeIP::event_id_t(0x8002), itsEventGroups, CommonAPI::SomeIP::event_type_e::ET_EVENT, CommonAPI::SomeIP::reliability_type_e::RT_RELIABLE);
+        }
     }
 
     // Register/Unregister event handlers for selective broadcasts
@@ -93,6 +107,32 @@ public:
 };
 
 
+template <typename _Stub, typename... _Stubs>
+void loggingSomeIPStubAdapterInternal<_Stub, _Stubs...>::fireTelemetryUpdateEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &_data) {
+    CommonAPI::Deployable< ::v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot, ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySnapshotDeployment_t> deployed_data(_data, static_cast< ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySnapshotDeployment_t* >(nullptr));
+    CommonAPI::SomeIP::StubEventHelper<CommonAPI::SomeIP::SerializableArguments<  CommonAPI::Deployable< ::v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot, ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySnapshotDeployment_t > 
+    >>
+        ::sendEvent(
+            *this,
+            CommonAPI::SomeIP::event_id_t(0x8001),
+            false,
+             deployed_data 
+    );
+}
+
+template <typename _Stub, typename... _Stubs>
+void loggingSomeIPStubAdapterInternal<_Stub, _Stubs...>::fireTelemetryBatchEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch &_samples) {
+    CommonAPI::Deployable< ::v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch, ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySampleBatchDeployment_t> deployed_samples(_samples, static_cast< ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySampleBatchDeployment_t* >(nullptr));
+    CommonAPI::SomeIP::StubEventHelper<CommonAPI::SomeIP::SerializableArguments<  CommonAPI::Deployable< ::v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch, ::v1::v1::logger::methods::TelemetryTypes_::TelemetrySampleBatchDeployment_t > 
+    >>
+        ::sendEvent(
+            *this,
+            CommonAPI::SomeIP::event_id_t(0x8002),
+            false,
+             deployed_samples 
+    );
+}
+
 template <typename _Stub, typename... _Stubs>
 void loggingSomeIPStubAdapterInternal<_Stub, _Stubs...>::registerSelectiveEventHandlers() {
 
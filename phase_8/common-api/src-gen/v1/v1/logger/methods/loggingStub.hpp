@@ -57,6 +57,17 @@ class loggingStubAdapter
  public:
 
 
+    /**
+     * Sends a broadcast event for telemetryUpdate. Should not be called directly.
+     * Instead, the "fire<broadcastName>Event" methods of the stub should be used.
+     */
+    virtual void fireTelemetryUpdateEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &_data) = 0;
+    /**
+     * Sends a broadcast event for telemetryBatch. Should not be called directly.
+     * Instead, the "fire<broadcastName>Event" methods of the stub should be used.
+     */
+    virtual void fireTelemetryBatchEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch &_samples) = 0;
+
     virtual void deactivateManagedInstances() = 0;
 
 
@@ -102,12 +113,24 @@ public:
     virtual ~loggingStub() {}
     void lockInterfaceVersionAttribute(bool _lockAccess) { static_cast<void>(_lockAccess); }
     bool hasElement(const uint32_t _id) const {
-        return (_id < 1);
+        return (_id < 3);
     }
     virtual const CommonAPI::Version& getInterfaceVersion(std::shared_ptr<CommonAPI::ClientId> _client) = 0;
 
     /// This is the method that will be called on remote calls on the method requestData.
     virtual void requestData(const std::shared_ptr<CommonAPI::ClientId> _client, requestDataReply_t _reply) = 0;
+    /// Sends a broadcast event for telemetryUpdate.
+    virtual void fireTelemetryUpdateEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &_data) {
+        auto stubAdapter = CommonAPI::Stub<loggingStubAdapter, loggingStubRemoteEvent>::stubAdapter_.lock();
+        if (stubAdapter)
+            stubAdapter->fireTelemetryUpdateEvent(_data);
+    }
+    /// Sends a broadcast event for telemetryBatch.
+    virtual void fireTelemetryBatchEvent(const ::v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch &_samples) {
+        auto stubAdapter = CommonAPI::Stub<loggingStubAdapter, loggingStubRemoteEvent>::stubAdapter_.lock();
+        if (stubAdapter)
+            stubAdapter->fireTelemetryBatchEvent(_samples);
+    }
 
 
     using CommonAPI::Stub<loggingStubAdapter, loggingStubRemoteEvent>::initStubAdapter;
@@ -0,0 +1,127 @@
+#include "HistoryBuffer.h"
+
+#include <algorithm>
+
+HistoryBuffer::HistoryBuffer()
+{
+    for (Level &level : m_levels)
+        level.ring.resize(LEVEL_CAPACITY);
+}
+
+void HistoryBuffer::clear()
+{
+    for (Level &level : m_levels) {
+        level.written = 0;
+        level.partialCount = 0;
+    }
+    m_total = 0;
+}
+
+int64_t HistoryBuffer::bucketSamples(int level)
+{
+    int64_t samples = 1;
+    for (int i = 0; i < level; ++i)
+        samples *= FACTOR;
+    return samples;
+}
+
+void HistoryBuffer::append(double value)
+{
+    ++m_total;
+    push(0, Bucket{value, value});
+}
+
+void HistoryBuffer::push(int level, const Bucket &bucket)
+{
+    Level &l = m_levels[level];
+    l.ring[static_cast<size_t>(l.written % LEVEL_CAPACITY)] = bucket;
+    ++l.written;
+
+    if (level + 1 == LEVELS)
+        return;
+
+    Level &up = m_levels[level + 1];
+    if (up.partialCount == 0) {
+        up.partial = bucket;
+    } else {
+        up.partial.min = std::min(up.partial.min, bucket.min);
+        up.partial.max = std::max(up.partial.max, bucket.max);
+    }
+    if (++up.partialCount == FACTOR) {
+        up.partialCount = 0;
+        push(level + 1, up.partial);
+    }
+}
+
+int64_t HistoryBuffer::bucketCount(int level) const
+{
+    const Level &l = m_levels[level];
+    return std::min<int64_t>(l.written, LEVEL_CAPACITY) + (l.partialCount > 0 ? 1 : 0);
+}
+
+bool HistoryBuffer::newest(int level, int64_t back, Bucket &out) const
+{
+    const Level &l = m_levels[level];
+    if (l.partialCount > 0) {
+        if (back == 0) {
+            out = l.partial;
+            return true;
+        }
+        --back;
+    }
+    if (back >= std::min<int64_t>(l.written, LEVEL_CAPACITY))
+        return false;
+    out = l.ring[static_cast<size_t>((l.written - 1 - back) % LEVEL_CAPACITY)];
+    return true;
+}
+
+int64_t HistoryBuffer::available() const
+{
+    int64_t reach = 0;
+    for (int level = 0; level < LEVELS; ++level)
+        reach = std::max(reach, bucketCount(level) * bucketSamples(level));
+    return std::min(m_total, reach);
+}
+
+void HistoryBuffer::downsample(int64_t span, int columns, std::vector<Bucket> &out) const
+{
+    out.clear();
+    if (m_total == 0 || columns <= 0)
+        return;
+    span = std::max<int64_t>(1, std::min(span, available()));
+
+    // finest level that still reaches back span samples ...
+    int level = 0;
+    while (level + 1 < LEVELS && bucketCount(level) * bucketSamples(level) < span)
+        ++level;
+    // ... made coarser while its buckets stay narrower than a column
+    while (level + 1 < LEVELS && bucketSamples(level + 1) * columns <= span)
+        ++level;
+
+    const int64_t width = bucketSamples(level);
+    const int64_t n = std::min(bucketCount(level), (span + width - 1) / width);
+    const int64_t rows = std::min<int64_t>(n, columns);
+    out.reserve(static_cast<size_t>(rows));
+
+    for (int64_t row = 0; row < rows; ++row) {
+        // buckets [first, last) counted from the oldest one shown
+        const int64_t first = row * n / rows;
+        const int64_t last = (row + 1) * n / rows;
+        Bucket merged{0.0, 0.0};
+        bool any = false;
+        for (int64_t i = first; i < last; ++i) {
+            Bucket b;
+            if (!newest(level, n - 1 - i, b))
+                continue;
+            if (!any) {
+                merged = b;
+                any = true;
+            } else {
+                merged.min = std::min(merged.min, b.min);
+                merged.max = std::max(merged.max, b.max);
+            }
+        }
+        if (any)
+            out.push_back(merged);
+    }
+}
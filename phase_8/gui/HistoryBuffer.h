@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity history of one value with pre-aggregated levels for zooming.
+// Level 0 keeps the newest LEVEL_CAPACITY raw samples; every level above keeps
+// LEVEL_CAPACITY min/max buckets of FACTOR buckets of the level below, so the
+// top level reaches back FACTOR^(LEVELS-1) times further (hours of samples at
+// 4 Hz). Appending is O(1) and never moves memory.
+//
+// downsample() reduces the newest `span` samples to at most `columns` min/max
+// pairs. It reads the coarsest level whose buckets are still narrower than a
+// column, so its cost is bounded by columns * FACTOR however long the history
+// is. Min/max (rather than LTTB) is used because it composes across levels
+// and never hides a spike.
+class HistoryBuffer
+{
+public:
+    struct Bucket {
+        double min;
+        double max;
+    };
+
+    static constexpr int      LEVELS         = 3;
+    static constexpr int      FACTOR         = 16;
+    static constexpr int      LEVEL_CAPACITY = 4096;
+    static constexpr int64_t  MAX_SAMPLES    = int64_t(LEVEL_CAPACITY) * FACTOR * FACTOR;
+
+    HistoryBuffer();
+
+    void append(double value);
+    void clear();
+
+    // samples that can still be shown, about MAX_SAMPLES at most
+    int64_t available() const;
+
+    // the newest span samples as at most `columns` buckets, oldest first
+    void downsample(int64_t span, int columns, std::vector<Bucket> &out) const;
+
+private:
+    struct Level {
+        std::vector<Bucket> ring;   // LEVEL_CAPACITY slots
+        int64_t written = 0;        // buckets ever completed
+        Bucket  partial{0.0, 0.0};  // bucket being filled from the level below
+        int     partialCount = 0;
+    };
+
+    static int64_t bucketSamples(int level);
+    void push(int level, const Bucket &bucket);
+    // bucket i counted back from the newest (0), including the partial one
+    bool newest(int level, int64_t back, Bucket &out) const;
+    int64_t bucketCount(int level) const;
+
+    Level m_levels[LEVELS];
+    int64_t m_total = 0;
+};
@@ -0,0 +1,101 @@
+#include "HistoryChart.h"
+
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+
+#include <algorithm>
+
+HistoryChart::HistoryChart(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void HistoryChart::setModel(HistoryModel *model)
+{
+    if (model == m_model)
+        return;
+    if (m_model)
+        disconnect(m_model, nullptr, this, nullptr);
+    m_model = model;
+    if (m_model) {
+        connect(m_model, &HistoryModel::refreshed, this, &QQuickItem::update);
+        m_model->setColumns(static_cast<int>(width()));
+    }
+    emit modelChanged();
+    update();
+}
+
+void HistoryChart::setColor(const QColor &color)
+{
+    if (color == m_color)
+        return;
+    m_color = color;
+    m_colorDirty = true;
+    emit colorChanged();
+    update();
+}
+
+void HistoryChart::setMaxValue(double maxValue)
+{
+    if (qFuzzyCompare(maxValue, m_maxValue))
+        return;
+    m_maxValue = maxValue;
+    emit maxValueChanged();
+    update();
+}
+
+void HistoryChart::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    // one model row per pixel column
+    if (m_model && newGeometry.width() != oldGeometry.width())
+        m_model->setColumns(static_cast<int>(newGeometry.width()));
+    update();
+}
+
+QSGNode *HistoryChart::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+        geometry->setLineWidth(2);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGFlatColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+        m_colorDirty = true;
+    }
+
+    if (m_colorDirty) {
+        static_cast<QSGFlatColorMaterial *>(node->material())->setColor(m_color);
+        node->markDirty(QSGNode::DirtyMaterial);
+        m_colorDirty = false;
+    }
+
+    const std::vector<HistoryBuffer::Bucket> empty;
+    const auto &rows = m_model ? m_model->buckets() : empty;
+    const int n = rows.size() > 1 ? static_cast<int>(rows.size()) : 0;
+
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(2 * n);
+    QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+
+    // rows fill the width, newest at the right edge, as the Canvas graph did
+    const double w = width();
+    const double h = height();
+    const double scale = m_maxValue > 0.0 ? h / m_maxValue : 0.0;
+    for (int i = 0; i < n; ++i) {
+        const float x = static_cast<float>(w * i / (n - 1));
+        const HistoryBuffer::Bucket &b = rows[static_cast<size_t>(i)];
+        // alternate the order so neighbouring rows join max to max and min to min
+        const double first  = (i % 2 == 0) ? b.min : b.max;
+        const double second = (i % 2 == 0) ? b.max : b.min;
+        v[2 * i].set(x, static_cast<float>(h - std::min(first, m_maxValue) * scale));
+        v[2 * i + 1].set(x, static_cast<float>(h - std::min(second, m_maxValue) * scale));
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+
+#include "HistoryModel.h"
+
+// Draws one HistoryModel as a scene-graph line strip: two vertices (min, max)
+// per model row, so a frame costs the chart's width in vertices and never
+// goes through a Canvas or JavaScript. Binds the model's `columns` to its own
+// width. The y axis runs from 0 at the bottom to maxValue at the top.
+class HistoryChart : public QQuickItem
+{
+    Q_OBJECT
+
+    Q_PROPERTY(HistoryModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(double maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+
+public:
+    explicit HistoryChart(QQuickItem *parent = nullptr);
+
+    HistoryModel *model() const { return m_model; }
+    void setModel(HistoryModel *model);
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+    double maxValue() const { return m_maxValue; }
+    void setMaxValue(double maxValue);
+
+signals:
+    void modelChanged();
+    void colorChanged();
+    void maxValueChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    QPointer<HistoryModel> m_model;
+    QColor m_color = Qt::white;
+    double m_maxValue = 100.0;
+    bool m_colorDirty = true;
+};
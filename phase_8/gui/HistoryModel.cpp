@@ -0,0 +1,76 @@
+#include "HistoryModel.h"
+
+#include <algorithm>
+
+HistoryModel::HistoryModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int HistoryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant HistoryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= static_cast<int>(m_rows.size()))
+        return QVariant();
+
+    const HistoryBuffer::Bucket &bucket = m_rows[static_cast<size_t>(index.row())];
+    switch (role) {
+    case MinRole:
+        return bucket.min;
+    case MaxRole:
+    case Qt::DisplayRole:
+        return bucket.max;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> HistoryModel::roleNames() const
+{
+    return {
+        { MinRole, "minValue" },
+        { MaxRole, "maxValue" },
+    };
+}
+
+void HistoryModel::setColumns(int columns)
+{
+    columns = std::max(1, columns);
+    if (columns == m_columns)
+        return;
+    m_columns = columns;
+    emit viewChanged();
+}
+
+void HistoryModel::setSpan(qint64 span)
+{
+    span = std::max<qint64>(2, std::min<qint64>(span, HistoryBuffer::MAX_SAMPLES));
+    if (span == m_span)
+        return;
+    m_span = span;
+    emit viewChanged();
+}
+
+void HistoryModel::setRows(std::vector<HistoryBuffer::Bucket> &rows, qint64 available)
+{
+    m_available = available;
+    m_maxValue = 0.0;
+    for (const HistoryBuffer::Bucket &bucket : rows)
+        m_maxValue = std::max(m_maxValue, bucket.max);
+
+    // the common case, a full chart, keeps its row count and only changes values
+    if (rows.size() == m_rows.size()) {
+        m_rows.swap(rows);
+        if (!m_rows.empty())
+            emit dataChanged(index(0), index(static_cast<int>(m_rows.size()) - 1));
+    } else {
+        beginResetModel();
+        m_rows.swap(rows);
+        endResetModel();
+    }
+    emit refreshed();
+}
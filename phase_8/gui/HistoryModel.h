@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QAbstractListModel>
+
+#include <vector>
+
+#include "HistoryBuffer.h"
+
+// One history series for the charts: one row per chart column, holding the
+// min and max of the samples that fall into it. QML sets `columns` to the
+// chart's pixel width and `span` to how many of the newest samples to show.
+// The HistoryBuffer lives on the parser thread (ParseWorker), which
+// downsamples it for this view; LogParser forwards viewChanged() there and
+// hands the finished rows back through setRows(), so the GUI thread only ever
+// handles about `columns` rows.
+class HistoryModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int columns READ columns WRITE setColumns NOTIFY viewChanged)
+    Q_PROPERTY(qint64 span READ span WRITE setSpan NOTIFY viewChanged)
+    Q_PROPERTY(qint64 available READ available NOTIFY refreshed)
+    Q_PROPERTY(double maxValue READ maxValue NOTIFY refreshed)
+
+public:
+    enum Roles {
+        MinRole = Qt::UserRole + 1,
+        MaxRole
+    };
+
+    explicit HistoryModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int columns() const { return m_columns; }
+    void setColumns(int columns);
+    qint64 span() const { return m_span; }
+    void setSpan(qint64 span);
+    qint64 available() const { return m_available; }
+    double maxValue() const { return m_maxValue; }   // of the rows shown
+
+    // the rows as they are, for chart items that draw them directly
+    const std::vector<HistoryBuffer::Bucket> &buckets() const { return m_rows; }
+
+    // swaps in rows downsampled for the current view; rows gets the old ones back
+    void setRows(std::vector<HistoryBuffer::Bucket> &rows, qint64 available);
+
+signals:
+    void viewChanged();
+    void refreshed();
+
+private:
+    std::vector<HistoryBuffer::Bucket> m_rows;
+    int    m_columns   = 600;
+    qint64 m_span      = 150;     // what the graph showed before zooming existed
+    qint64 m_available = 0;
+    double m_maxValue  = 0.0;
+};
@@ -1,152 +1,126 @@
 #include "LogParser.h"
 
-#include <QFile>
-#include <QTextStream>
-#include <QTimer>
-#include <QRegularExpression>
-#include <QDebug>
+#include <QQuickWindow>
 
 LogParser::LogParser(QObject *parent)
     : QObject(parent)
 {
+    m_worker = new ParseWorker;
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::started,
+            m_worker, &ParseWorker::init);
+    connect(&m_thread, &QThread::finished,
+            m_worker, &QObject::deleteLater);
+    // queued: the worker signals from the parser thread
+    connect(m_worker, &ParseWorker::snapshotReady,
+            this, &LogParser::onSnapshotReady);
+    // the history is downsampled on the parser thread for each chart's view
+    HistoryModel *models[SeriesCount] = {&m_cpuHist, &m_ramHist, &m_tempHist};
+    for (int series = 0; series < SeriesCount; ++series) {
+        HistoryModel *model = models[series];
+        auto sendView = [worker = m_worker, model, series] {
+            const int columns = model->columns();
+            const qint64 span = model->span();
+            QMetaObject::invokeMethod(worker, [worker, series, columns, span] {
+                worker->setHistoryView(series, columns, span);
+            });
+        };
+        connect(model, &HistoryModel::viewChanged, this, sendView);
+        sendView();
+    }
+    m_thread.setObjectName(QStringLiteral("LogParser"));
+    m_thread.start();
+
     // default; main.cpp will override with setLogFilePath(...)
-    m_logFilePath = QStringLiteral("telemetry.log");
+    setLogFilePath(QStringLiteral("telemetry.log"));
+}
 
-    auto *timer = new QTimer(this);
-    timer->setTimerType(Qt::PreciseTimer);
+LogParser::~LogParser()
+{
+    m_thread.quit();
+    m_thread.wait();
+}
 
-    connect(timer, &QTimer::timeout,
-            this, &LogParser::updateFromLog);
+void LogParser::setLogFilePath(const QString &path)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, path] { worker->setLogFilePath(path); });
+}
 
-    // check very often – we'll only read new bytes
-    timer->start(10);   // 10 ms
+void LogParser::addLogFilePath(const QString &path)
+{
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, path] { worker->addLogFilePath(path); });
 }
 
-QVariantList LogParser::cpuHistory() const
+void LogParser::attachSharedMemory(const QString &name)
 {
-    QVariantList out;
-    out.reserve(m_cpuHist.size());
-    for (double v : m_cpuHist)
-        out.push_back(v);
-    return out;
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, name] { worker->attachSharedMemory(name); });
 }
 
-QVariantList LogParser::ramHistory() const
+void LogParser::attachWindow(QQuickWindow *window)
 {
-    QVariantList out;
-    out.reserve(m_ramHist.size());
-    for (double v : m_ramHist)
-        out.push_back(v);
-    return out;
+    m_window = window;
+    // emitted on the GUI thread before every frame is synchronised with the render thread
+    connect(window, &QQuickWindow::afterAnimating, this, [this] {
+        if (m_frameRequested) {
+            m_frameRequested = false;
+            publishSnapshot();
+        }
+    });
 }
 
-QVariantList LogParser::tempHistory() const
+void LogParser::updateFromLog()
 {
-    QVariantList out;
-    out.reserve(m_tempHist.size());
-    for (double v : m_tempHist)
-        out.push_back(v);
-    return out;
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker] { worker->readNow(); });
 }
 
-void LogParser::pushHistory(double value,
-                            QVector<double> &hist,
-                            int maxSize)
+QVariantList LogParser::coreLoads() const
 {
-    hist.push_back(value);
-    if (hist.size() > maxSize)
-        hist.pop_front();
+    QVariantList out;
+    out.reserve(m_coreLoads.size());
+    for (double v : m_coreLoads)
+        out.push_back(v);
+    return out;
 }
 
-void LogParser::updateFromLog()
+void LogParser::onSnapshotReady()
 {
-    QFile file(m_logFilePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        // qWarning() << "[LogParser] Cannot open log file" << m_logFilePath;
+    if (!m_window) {
+        publishSnapshot();
         return;
     }
 
-    // On first run, start from the beginning (replay whole file once)
-    // If you want to ignore old content and only follow new data,
-    // set m_lastPos = file.size() the first time instead.
-    if (!m_initialized) {
-        m_lastPos = 0;
-        m_initialized = true;
-    }
-
-    // handle truncation/rotation
-    if (m_lastPos > file.size()) {
-        m_lastPos = 0;
+    // however much was parsed, QML sees it once, with the next frame
+    if (!m_frameRequested) {
+        m_frameRequested = true;
+        m_window->requestUpdate();
     }
+}
 
-    // Jump to where we stopped last time
-    file.seek(m_lastPos);
-
-    QTextStream in(&file);
-    in.setCodec("UTF-8");
-
-    static QRegularExpression reCpu (R"(CPU usage:\s*(\d+)\s*%)");
-    static QRegularExpression reRam (R"(RAM usage:\s*(\d+)\s*%)");
-    static QRegularExpression reTemp(R"(TEMP usage:\s*(\d+))");
-
-    bool anyChanged = false;
-
-    // 🔥 VALUE-BY-VALUE PROCESSING
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        m_lastPos = file.pos();   // remember how far we got
-
-        double oldCpu  = m_cpu;
-        double oldRam  = m_ram;
-        double oldTemp = m_temp;
-
-        bool localChange = false;
-
-        if (line.contains("TelemetryApp (CPU):")) {
-            QRegularExpressionMatch m = reCpu.match(line);
-            if (m.hasMatch()) {
-                double v = m.captured(1).toDouble();
-                if (!qFuzzyCompare(1.0 + v, 1.0 + m_cpu)) {
-                    m_cpu = v;
-                    pushHistory(m_cpu, m_cpuHist, m_maxHistory);
-                    localChange = true;
-                }
-            }
-        } else if (line.contains("TelemetryApp (RAM):")) {
-            QRegularExpressionMatch m = reRam.match(line);
-            if (m.hasMatch()) {
-                double v = m.captured(1).toDouble();
-                if (!qFuzzyCompare(1.0 + v, 1.0 + m_ram)) {
-                    m_ram = v;
-                    pushHistory(m_ram, m_ramHist, m_maxHistory);
-                    localChange = true;
-                }
-            }
-        } else if (line.contains("TelemetryApp (TEMP):")) {
-            QRegularExpressionMatch m = reTemp.match(line);
-            if (m.hasMatch()) {
-                double v = m.captured(1).toDouble();
-                if (!qFuzzyCompare(1.0 + v, 1.0 + m_temp)) {
-                    m_temp = v;
-                    pushHistory(m_temp, m_tempHist, m_maxHistory);
-                    localChange = true;
-                }
-            }
-        }
+void LogParser::publishSnapshot()
+{
+    m_worker->take(m_snapshot);
 
-        if (localChange) {
-            anyChanged = true;
-            emit valuesChanged();
-            emit historyChanged();
+    if (m_snapshot.valuesChanged) {
+        m_cpu  = m_snapshot.cpu;
+        m_ram  = m_snapshot.ram;
+        m_temp = m_snapshot.temp;
+        emit valuesChanged();
+    }
 
-            // optional debug:
-            // qDebug() << "[LogParser] line:" << line
-            //          << "CPU" << m_cpu << "RAM" << m_ram << "TEMP" << m_temp;
+    // the rows arrive downsampled, at most chart-width of them per series
+    HistoryModel *models[SeriesCount] = {&m_cpuHist, &m_ramHist, &m_tempHist};
+    bool historyUpdated = false;
+    for (int series = 0; series < SeriesCount; ++series) {
+        HistoryRows &rows = m_snapshot.history[series];
+        if (rows.changed) {
+            models[series]->setRows(rows.buckets, rows.available);
+            historyUpdated = true;
         }
     }
-
-    file.close();
-
-    // we already emitted per-value; nothing to do here
-    Q_UNUSED(anyChanged);
+    if (historyUpdated)
+        emit historyChanged();
+    if (m_snapshot.coresChanged) {
+        m_coreLoads = m_snapshot.coreLoads;
+        emit coresChanged();
+    }
 }
\ No newline at end of file
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <QObject>
+#include <QPointer>
+#include <QThread>
 #include <QVector>
 #include <QVariant>
 #include <QString>
 
+#include "HistoryModel.h"
+#include "ParseWorker.h"
+
+class QQuickWindow;
+
 class LogParser : public QObject
 {
     Q_OBJECT
@@ -12,48 +19,59 @@ class LogParser : public QObject
     Q_PROPERTY(double cpu  READ cpu  NOTIFY valuesChanged)
     Q_PROPERTY(double ram  READ ram  NOTIFY valuesChanged)
     Q_PROPERTY(double temp READ temp NOTIFY valuesChanged)
+    Q_PROPERTY(QVariantList coreLoads READ coreLoads NOTIFY coresChanged)
+    // history for the graph
+    Q_PROPERTY(HistoryModel *cpuHistory  READ cpuHistory  CONSTANT)
+    Q_PROPERTY(HistoryModel *ramHistory  READ ramHistory  CONSTANT)
+    Q_PROPERTY(HistoryModel *tempHistory READ tempHistory CONSTANT)
 
 public:
     explicit LogParser(QObject *parent = nullptr);
+    ~LogParser() override;
 
     double cpu()  const { return m_cpu; }
     double ram()  const { return m_ram; }
     double temp() const { return m_temp; }
+    QVariantList coreLoads() const;
+    HistoryModel *cpuHistory()  { return &m_cpuHist; }
+    HistoryModel *ramHistory()  { return &m_ramHist; }
+    HistoryModel *tempHistory() { return &m_tempHist; }
 
-    // main.cpp uses this
-    void setLogFilePath(const QString &path) { m_logFilePath = path; }
-
-    // history for the graph
-    Q_INVOKABLE QVariantList cpuHistory() const;
-    Q_INVOKABLE QVariantList ramHistory() const;
-    Q_INVOKABLE QVariantList tempHistory() const;
+    // main.cpp uses this; each sink file (cpu.log, ram.log, temp.log) is tailed separately
+    void setLogFilePath(const QString &path);
+    void addLogFilePath(const QString &path);
+    // read values from the server's (TELEMETRY_SHM) or logger's ("sinks": {"shm": ...}) ring instead of the files
+    void attachSharedMemory(const QString &name);
+    // publish parsed values in step with this window's frames instead of as soon as they arrive
+    void attachWindow(QQuickWindow *window);
 
 public slots:
     void updateFromLog();
 
 signals:
     void valuesChanged();    // CPU/RAM/TEMP updated
-    void historyChanged();   // history arrays updated
+    void historyChanged();   // the history models got new rows
+    void coresChanged();     // a "CPU<n> usage" line changed a core
 
 private:
-    void pushHistory(double value,
-                     QVector<double> &hist,
-                     int maxSize);
+    void onSnapshotReady();
+    void publishSnapshot();
 
 private:
-    QString m_logFilePath;
+    // parsing runs on m_thread; the GUI thread only takes finished snapshots
+    QThread m_thread;
+    ParseWorker *m_worker = nullptr;   // deleted on m_thread when it finishes
+    QPointer<QQuickWindow> m_window;
+    ParseSnapshot m_snapshot;          // reused across takes
+    bool m_frameRequested = false;
 
     double m_cpu  = 0.0;
     double m_ram  = 0.0;
     double m_temp = 0.0;
 
-    QVector<double> m_cpuHist;
-    QVector<double> m_ramHist;
-    QVector<double> m_tempHist;
-
-    int m_maxHistory = 500;
+    QVector<double> m_coreLoads;   // indexed by core, grows with the highest core seen
 
-    // tailing state
-    qint64 m_lastPos   = 0;   // where we stopped reading last time
-    bool   m_initialized = false;
+    HistoryModel m_cpuHist;
+    HistoryModel m_ramHist;
+    HistoryModel m_tempHist;
 };
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "LogTailer.h"
+
+#include <QFileInfo>
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include <sys/stat.h>
+
+// a large backlog is replayed in slices, so the buffer never holds a whole file
+static constexpr qint64 READ_CHUNK = 1 << 20;
+
+LogTailer::LogTailer(Handler handler, QObject *parent)
+    : QObject(parent),
+      m_handler(std::move(handler)),
+      m_watcher(this)
+{
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &LogTailer::onFileChanged);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &LogTailer::onDirectoryChanged);
+}
+
+void LogTailer::addFile(const QString &path)
+{
+    m_files.push_back(std::make_unique<TailedFile>());
+    TailedFile &tailed = *m_files.back();
+    tailed.path = path;
+
+    const QString dir = QFileInfo(path).absolutePath();
+    if (!m_watcher.directories().contains(dir))
+        m_watcher.addPath(dir);
+
+    // each file starts at offset 0, so the whole file is replayed once
+    if (open(tailed))
+        readNewLines(tailed);
+}
+
+void LogTailer::clearFiles()
+{
+    if (!m_watcher.files().isEmpty())
+        m_watcher.removePaths(m_watcher.files());
+    if (!m_watcher.directories().isEmpty())
+        m_watcher.removePaths(m_watcher.directories());
+    m_files.clear();
+}
+
+void LogTailer::readAll()
+{
+    for (auto &tailed : m_files)
+        readNewLines(*tailed);
+}
+
+bool LogTailer::open(TailedFile &tailed)
+{
+    tailed.file.close();
+    tailed.file.setFileName(tailed.path);
+    tailed.inode = 0;
+    tailed.lastPos = 0;
+    tailed.pending.clear();
+
+    // unbuffered: every read is one pread-style syscall at lastPos, nothing cached by QFile
+    if (!tailed.file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        return false;
+
+    struct stat st;
+    if (::fstat(tailed.file.handle(), &st) == 0)
+        tailed.inode = st.st_ino;
+    watch(tailed);
+    return true;
+}
+
+void LogTailer::watch(const TailedFile &tailed)
+{
+    // Qt drops a file from the watch list when it is removed or renamed
+    if (!m_watcher.files().contains(tailed.path))
+        m_watcher.addPath(tailed.path);
+}
+
+void LogTailer::readNewLines(TailedFile &tailed)
+{
+    if (!tailed.file.isOpen())
+        return;
+
+    struct stat st;
+    if (::fstat(tailed.file.handle(), &st) != 0)
+        return;
+    const qint64 size = st.st_size;
+
+    // handle truncation
+    if (size < tailed.lastPos) {
+        tailed.lastPos = 0;
+        tailed.pending.clear();
+    }
+
+    bool any = false;
+    while (tailed.lastPos < size) {
+        const qint64 want = qMin(size - tailed.lastPos, READ_CHUNK);
+        const int kept = tailed.pending.size();
+        tailed.pending.resize(kept + static_cast<int>(want));
+
+        qint64 got = -1;
+        if (tailed.file.seek(tailed.lastPos))
+            got = tailed.file.read(tailed.pending.data() + kept, want);
+        if (got <= 0) {
+            tailed.pending.resize(kept);
+            break;
+        }
+        tailed.pending.resize(kept + static_cast<int>(got));
+        tailed.lastPos += got;
+
+        // hand out every complete line and keep the unfinished one
+        const char *begin = tailed.pending.constData();
+        const char *end = begin + tailed.pending.size();
+        const char *p = begin;
+        while (const void *found = std::memchr(p, '\n', static_cast<size_t>(end - p))) {
+            const char *nl = static_cast<const char *>(found);
+            Value value;
+            if (scanLine(p, nl, value)) {
+                m_handler(value);
+                any = true;
+            }
+            p = nl + 1;
+        }
+        tailed.pending.remove(0, static_cast<int>(p - begin));
+
+        // once per slice, so a long backlog shows progress while it is read
+        if (any)
+            emit valuesRead();
+        any = false;
+    }
+}
+
+void LogTailer::onFileChanged(const QString &path)
+{
+    for (auto &ptr : m_files) {
+        TailedFile &tailed = *ptr;
+        if (tailed.path != path)
+            continue;
+
+        // whatever the old inode still holds comes first
+        readNewLines(tailed);
+
+        struct stat st;
+        if (::stat(QFile::encodeName(path).constData(), &st) != 0) {
+            // deleted or renamed away; the directory watch brings it back
+            tailed.file.close();
+        } else if (!tailed.file.isOpen() || st.st_ino != tailed.inode) {
+            if (open(tailed))
+                readNewLines(tailed);
+        } else {
+            watch(tailed);
+        }
+    }
+}
+
+void LogTailer::onDirectoryChanged(const QString &dir)
+{
+    // a file was created, removed or renamed next to our logs
+    for (auto &ptr : m_files) {
+        if (QFileInfo(ptr->path).absolutePath() == dir)
+            onFileChanged(ptr->path);
+    }
+}
+
+bool LogTailer::scanLine(const char *p, const char *end, Value &out)
+{
+    std::string_view line(p, static_cast<size_t>(end - p));
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+
+    // "... TelemetryApp (<CONTEXT>): <CONTEXT>[<core>] usage: <value>..."
+    constexpr std::string_view tag = "TelemetryApp (";
+    const size_t at = line.find(tag);
+    if (at == std::string_view::npos)
+        return false;
+    line.remove_prefix(at + tag.size());
+
+    const size_t close = line.find("): ");
+    if (close == std::string_view::npos)
+        return false;
+    const std::string_view context = line.substr(0, close);
+    line.remove_prefix(close + 3);
+
+    if (context == "CPU")
+        out.context = TelemetrySrc_enum::CPU;
+    else if (context == "RAM")
+        out.context = TelemetrySrc_enum::RAM;
+    else if (context == "TEMP")
+        out.context = TelemetrySrc_enum::TEMP;
+    else
+        return false;
+
+    if (line.substr(0, context.size()) != context)
+        return false;
+    line.remove_prefix(context.size());
+
+    out.core = -1;
+    if (out.context == TelemetrySrc_enum::CPU && !line.empty() && line.front() >= '0' && line.front() <= '9') {
+        out.core = 0;
+        for (int digits = 0; !line.empty() && line.front() >= '0' && line.front() <= '9'; ++digits) {
+            if (digits == 6)
+                return false;
+            out.core = out.core * 10 + (line.front() - '0');
+            line.remove_prefix(1);
+        }
+    }
+
+    // labelled values ("TEMP x86_pkg_temp usage: ...") are per-sensor metrics, not the gauge
+    constexpr std::string_view usage = " usage:";
+    if (line.substr(0, usage.size()) != usage)
+        return false;
+    line.remove_prefix(usage.size());
+    while (!line.empty() && line.front() == ' ')
+        line.remove_prefix(1);
+
+    double value = 0.0;
+    bool any = false;
+    while (!line.empty() && line.front() >= '0' && line.front() <= '9') {
+        value = value * 10.0 + (line.front() - '0');
+        line.remove_prefix(1);
+        any = true;
+    }
+    if (!line.empty() && line.front() == '.') {
+        line.remove_prefix(1);
+        for (double scale = 0.1; !line.empty() && line.front() >= '0' && line.front() <= '9'; scale /= 10.0) {
+            value += (line.front() - '0') * scale;
+            line.remove_prefix(1);
+            any = true;
+        }
+    }
+    if (!any)
+        return false;
+
+    out.value = value;
+    return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "logtype.hpp"
+
+// Follows the sink log files (cpu.log, ram.log, temp.log) without polling.
+// Each file stays open; inotify (QFileSystemWatcher) wakes us only when it
+// changes, and only the new bytes are read into a per-file buffer that keeps
+// an unfinished last line for the next read. Truncation starts over from the
+// beginning, and a file that is replaced (rotated, or deleted and created
+// again) is drained and then reopened from the new inode.
+class LogTailer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // one value found in a log line
+    struct Value {
+        TelemetrySrc_enum context;
+        int    core;    // -1 for the aggregate value, else the "CPU<n>" core
+        double value;
+    };
+    using Handler = std::function<void(const Value &)>;
+
+    explicit LogTailer(Handler handler, QObject *parent = nullptr);
+
+    // the file does not need to exist yet; its directory is watched for it
+    void addFile(const QString &path);
+    void clearFiles();
+
+    // reads whatever was appended to every file since the last read
+    void readAll();
+
+    // "[time] [SEV] TelemetryApp (CPU): CPU3 usage: 97% ..." -> CPU, 3, 97
+    // only CPU, CPU<n>, RAM and TEMP lines without a label produce a value
+    static bool scanLine(const char *p, const char *end, Value &out);
+
+signals:
+    // after each read slice that handed at least one value to the handler
+    void valuesRead();
+
+private slots:
+    void onFileChanged(const QString &path);
+    void onDirectoryChanged(const QString &dir);
+
+private:
+    struct TailedFile {
+        QString    path;
+        QFile      file;
+        ino_t      inode   = 0;
+        qint64     lastPos = 0;   // where we stopped reading last time
+        QByteArray pending;       // bytes after the last '\n'
+    };
+
+    bool open(TailedFile &tailed);
+    void readNewLines(TailedFile &tailed);
+    void watch(const TailedFile &tailed);
+
+    Handler m_handler;
+    QFileSystemWatcher m_watcher;
+    std::vector<std::unique_ptr<TailedFile>> m_files;
+};
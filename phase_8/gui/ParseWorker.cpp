@@ -0,0 +1,222 @@
+#include "ParseWorker.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSocketNotifier>
+
+#include <algorithm>
+#include <iterator>
+
+ParseWorker::~ParseWorker()
+{
+    // the notifier must go before the waiter closes its fd
+    delete m_shmNotifier;
+}
+
+void ParseWorker::init()
+{
+    m_tailer = std::make_unique<LogTailer>([this](const LogTailer::Value &value) { applyValue(value); });
+    connect(m_tailer.get(), &LogTailer::valuesRead,
+            this, &ParseWorker::publish);
+}
+
+void ParseWorker::setLogFilePath(const QString &path)
+{
+    m_tailer->clearFiles();
+    m_tailer->addFile(path);
+}
+
+void ParseWorker::addLogFilePath(const QString &path)
+{
+    m_tailer->addFile(path);
+}
+
+void ParseWorker::attachSharedMemory(const QString &name)
+{
+    m_tailer->clearFiles();
+
+    m_shm = std::make_unique<ShmRingReader>(name.toStdString());
+    // the backlog fills the graphs straight away
+    if (!m_shm->open(true))
+        qWarning() << "[LogParser] Shared memory ring" << name << "not available yet";
+
+    // the waiter's eventfd fires when the writer notifies, so an idle ring costs nothing
+    delete m_shmNotifier;
+    m_shmNotifier = nullptr;
+    m_shmWaiter = std::make_unique<ShmRingWaiter>(name.toStdString());
+    if (!m_shmWaiter->start()) {
+        qWarning() << "[LogParser] Cannot wait on shared memory ring" << name;
+        return;
+    }
+    m_shmNotifier = new QSocketNotifier(m_shmWaiter->getFd(), QSocketNotifier::Read, this);
+    // string-based: Qt 5.15 overloads activated(), which breaks taking its address
+    connect(m_shmNotifier, SIGNAL(activated(int)),
+            this, SLOT(readNow()));
+}
+
+void ParseWorker::readNow()
+{
+    if (m_shm) {
+        if (m_shmWaiter)
+            m_shmWaiter->clear();
+        readSharedMemory();
+        publish();
+    } else if (m_tailer) {
+        m_tailer->readAll();
+    }
+}
+
+void ParseWorker::setHistoryView(int series, int columns, qint64 span)
+{
+    if (series < 0 || series >= SeriesCount)
+        return;
+    m_views[series] = HistoryView{std::max(1, columns), std::max<qint64>(2, span)};
+    m_historyStale[series] = true;
+    publish();
+}
+
+void ParseWorker::take(ParseSnapshot &out)
+{
+    QMutexLocker lock(&m_mutex);
+    out = std::move(m_pending);
+    m_pending = ParseSnapshot{};
+    m_dirty = false;
+
+    // rows left stale while the snapshot waited are rebuilt on the parser thread
+    if (m_historyWaiting) {
+        m_historyWaiting = false;
+        QMetaObject::invokeMethod(this, [this] { publish(); }, Qt::QueuedConnection);
+    }
+}
+
+bool ParseWorker::updateValue(double value, double &current, HistorySeries series)
+{
+    if (qFuzzyCompare(1.0 + value, 1.0 + current))
+        return false;
+    current = value;
+    m_history[series].append(value);
+    m_historyStale[series] = true;
+    return true;
+}
+
+void ParseWorker::applyValue(const LogTailer::Value &value)
+{
+    switch (value.context) {
+    case TelemetrySrc_enum::CPU:
+        if (value.core < 0) {
+            m_working.valuesChanged |= updateValue(value.value, m_working.cpu, CpuSeries);
+            break;
+        }
+        // per-core lines share the CPU context but only feed the core strip
+        if (value.core >= m_working.coreLoads.size())
+            m_working.coreLoads.resize(value.core + 1);
+        if (!qFuzzyCompare(1.0 + value.value, 1.0 + m_working.coreLoads[value.core])) {
+            m_working.coreLoads[value.core] = value.value;
+            m_working.coresChanged = true;
+        }
+        break;
+    case TelemetrySrc_enum::RAM:
+        m_working.valuesChanged |= updateValue(value.value, m_working.ram, RamSeries);
+        break;
+    case TelemetrySrc_enum::TEMP:
+        m_working.valuesChanged |= updateValue(value.value, m_working.temp, TempSeries);
+        break;
+    default:
+        break;
+    }
+}
+
+void ParseWorker::readSharedMemory()
+{
+    m_shmRecords.clear();
+    if (m_shm->read(m_shmRecords) == 0) {
+        // nothing new: the writer may be gone or restarted with a fresh ring
+        if (m_shm->isStale())
+            m_shm->open(true);
+        return;
+    }
+
+    for (const ShmRecord &record : m_shmRecords) {
+        const std::string_view label = record.getLabel();
+        LogTailer::Value value{record.getContext(), -1, record.value};
+        if (!label.empty()) {
+            // per-core records carry the core number as label; other labels
+            // (per-sensor TEMP, collector metrics) are not shown
+            if (value.context != TelemetrySrc_enum::CPU)
+                continue;
+            value.core = QString::fromLatin1(label.data(), static_cast<int>(label.size())).toInt();
+        }
+        applyValue(value);
+    }
+}
+
+// rebuilds the rows of every stale series into m_working; true if any was
+bool ParseWorker::downsampleHistory()
+{
+    bool any = false;
+    for (int series = 0; series < SeriesCount; ++series) {
+        if (!m_historyStale[series])
+            continue;
+        HistoryRows &rows = m_working.history[series];
+        m_history[series].downsample(m_views[series].span, m_views[series].columns, rows.buckets);
+        rows.available = m_history[series].available();
+        rows.changed = true;
+        m_historyStale[series] = false;
+        any = true;
+    }
+    return any;
+}
+
+void ParseWorker::publish()
+{
+    const bool historyStale = std::any_of(std::begin(m_historyStale), std::end(m_historyStale),
+                                          [](bool stale) { return stale; });
+    if (!m_working.valuesChanged && !m_working.coresChanged && !historyStale)
+        return;
+
+    // rows are rebuilt at most once per hand-over: while the GUI has not taken
+    // the previous snapshot, take() asks for another publish() instead
+    bool taken;
+    {
+        QMutexLocker lock(&m_mutex);
+        taken = !m_dirty;
+    }
+    const bool historyChanged = taken && downsampleHistory();
+    if (!m_working.valuesChanged && !m_working.coresChanged && !historyChanged) {
+        QMutexLocker lock(&m_mutex);
+        if (m_dirty)
+            m_historyWaiting = true;
+        else    // taken since the check above; nobody would ask again
+            QMetaObject::invokeMethod(this, [this] { publish(); }, Qt::QueuedConnection);
+        return;
+    }
+
+    bool wasDirty;
+    {
+        QMutexLocker lock(&m_mutex);
+        wasDirty = m_dirty;
+        m_dirty = true;
+
+        m_pending.cpu  = m_working.cpu;
+        m_pending.ram  = m_working.ram;
+        m_pending.temp = m_working.temp;
+        m_pending.valuesChanged |= m_working.valuesChanged;
+        if (m_working.coresChanged) {
+            m_pending.coreLoads = m_working.coreLoads;
+            m_pending.coresChanged = true;
+        }
+        for (int series = 0; series < SeriesCount; ++series) {
+            if (m_working.history[series].changed)
+                std::swap(m_pending.history[series], m_working.history[series]);
+            m_working.history[series].changed = false;
+        }
+        m_historyWaiting = !historyChanged && historyStale;
+    }
+
+    m_working.valuesChanged = false;
+    m_working.coresChanged = false;
+
+    // the GUI already has a wake-up queued for the previous changes
+    if (!wasDirty)
+        emit snapshotReady();
+}
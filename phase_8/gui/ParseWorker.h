@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+#include "HistoryBuffer.h"
+#include "LogTailer.h"
+#include "shmring.hpp"
+
+class QSocketNotifier;
+
+// the history series, in the order of ParseSnapshot::history
+enum HistorySeries {
+    CpuSeries,
+    RamSeries,
+    TempSeries,
+    SeriesCount
+};
+
+// one series downsampled for its chart's view
+struct HistoryRows {
+    std::vector<HistoryBuffer::Bucket> buckets;   // oldest first
+    qint64 available = 0;
+    bool changed = false;
+};
+
+// everything the dashboard shows, as of one hand-over
+struct ParseSnapshot {
+    double cpu  = 0.0;
+    double ram  = 0.0;
+    double temp = 0.0;
+    QVector<double> coreLoads;
+    HistoryRows history[SeriesCount];
+
+    bool valuesChanged = false;
+    bool coresChanged  = false;
+};
+
+// Reads the log files (LogTailer) or the shared-memory ring on its own thread
+// and folds every value into a pending ParseSnapshot. The GUI thread takes
+// that snapshot at most once per frame, so a burst of thousands of lines costs
+// the UI one property update instead of thousands.
+//
+// The history buffers live here too: appending and the min/max levels cost
+// the parser thread, and the rows for each chart's view are rebuilt at most
+// once per hand-over, so the GUI gets at most `columns` rows per series.
+//
+// Lives on the parser thread; call the slots through queued invocations.
+class ParseWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    ParseWorker() = default;
+    ~ParseWorker() override;
+
+    // GUI thread: moves the pending changes into out (replacing its contents)
+    void take(ParseSnapshot &out);
+
+public slots:
+    void init();   // connected to QThread::started
+    void setLogFilePath(const QString &path);
+    void addLogFilePath(const QString &path);
+    void attachSharedMemory(const QString &name);
+    void readNow();
+    // the chart of `series` shows the newest span samples in `columns` rows
+    void setHistoryView(int series, int columns, qint64 span);
+
+signals:
+    // emitted once when the pending snapshot goes from clean to dirty
+    void snapshotReady();
+
+private:
+    struct HistoryView {
+        int    columns = 1;
+        qint64 span    = 2;
+    };
+
+    bool updateValue(double value, double &current, HistorySeries series);
+    bool downsampleHistory();
+    void applyValue(const LogTailer::Value &value);
+    void readSharedMemory();
+    void publish();
+
+    std::unique_ptr<LogTailer> m_tailer;     // created on the parser thread by init()
+    std::unique_ptr<ShmRingReader> m_shm;
+    std::unique_ptr<ShmRingWaiter> m_shmWaiter;
+    std::vector<ShmRecord> m_shmRecords;
+    QSocketNotifier *m_shmNotifier = nullptr;
+
+    ParseSnapshot m_working;   // parser thread only
+    HistoryBuffer m_history[SeriesCount];
+    HistoryView m_views[SeriesCount];
+    bool m_historyStale[SeriesCount] = {};
+
+    QMutex m_mutex;            // guards m_pending, m_dirty and m_historyWaiting
+    ParseSnapshot m_pending;
+    bool m_dirty = false;
+    bool m_historyWaiting = false;   // history changed while m_pending was still untaken
+};
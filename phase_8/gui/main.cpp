@@ -1,16 +1,32 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
+#include <QtQml/qqml.h>
 
+#include "HistoryChart.h"
+#include "HistoryModel.h"
 #include "LogParser.h"
 
 int main(int argc, char *argv[])
 {
     QGuiApplication app(argc, argv);
 
+    qmlRegisterType<HistoryChart>("Telemetry", 1, 0, "HistoryChart");
+    qmlRegisterUncreatableType<HistoryModel>("Telemetry", 1, 0, "HistoryModel",
+                                             QStringLiteral("provided by logParser"));
+
     LogParser parser;
     // If your log path is fixed somewhere else:
-    parser.setLogFilePath("/home/abdo/projects/linux/C++/project/TelementryLoggingSystem/phase_8/build/cpu.log");
+    // LogManager routes each context to its own file, so follow all three
+    const QString logDir = "/home/abdo/projects/linux/C++/project/TelementryLoggingSystem/phase_8/build/";
+    parser.setLogFilePath(logDir + "cpu.log");
+    parser.addLogFilePath(logDir + "ram.log");
+    parser.addLogFilePath(logDir + "temp.log");
+
+    // TELEMETRY_SHM=<name> reads the shared-memory ring instead of re-parsing the files
+    if (qEnvironmentVariableIsSet("TELEMETRY_SHM"))
+        parser.attachSharedMemory(qEnvironmentVariable("TELEMETRY_SHM"));
 
     QQmlApplicationEngine engine;
 
@@ -21,5 +37,9 @@ int main(int argc, char *argv[])
     if (engine.rootObjects().isEmpty())
         return -1;
 
+    // parsed values reach QML at most once per frame
+    if (auto *window = qobject_cast<QQuickWindow *>(engine.rootObjects().first()))
+        parser.attachWindow(window);
+
     return app.exec();
 }
\ No newline at end of file
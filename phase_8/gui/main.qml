@@ -2,6 +2,7 @@ import QtQuick 2.15
 import QtQuick.Window 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Telemetry 1.0
 
 ApplicationWindow {
     id: root
@@ -462,6 +463,42 @@ ApplicationWindow {
             }
         }
 
+        // ===== PER-CORE STRIP (hidden until the logger reports cores) =====
+        Row {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 40
+            visible: logParser.coreLoads.length > 0
+            spacing: 2
+
+            Repeater {
+                model: logParser.coreLoads
+
+                Rectangle {
+                    width: Math.max(4, (parent.width - 2 * (logParser.coreLoads.length - 1))
+                                       / logParser.coreLoads.length)
+                    height: 40
+                    color: "#11141b"
+                    border.color: "#13171f"
+
+                    Rectangle {
+                        anchors.bottom: parent.bottom
+                        width: parent.width
+                        height: parent.height * Math.min(modelData, 100) / 100
+                        color: modelData > 90 ? "#ff5252" : (modelData > 75 ? "#ffb300" : "#26c65b")
+                    }
+
+                    ToolTip.visible: coreHover.containsMouse
+                    ToolTip.text: "CPU" + index + ": " + modelData.toFixed(0) + " %"
+
+                    MouseArea {
+                        id: coreHover
+                        anchors.fill: parent
+                        hoverEnabled: true
+                    }
+                }
+            }
+        }
+
         // ===== BOTTOM: HISTORY GRAPH =====
         Rectangle {
             Layout.fillWidth: true
@@ -470,135 +507,138 @@ ApplicationWindow {
             color: "#05070a"
             border.color: "#13171f"
 
-            Canvas {
-                id: historyCanvas
+            Item {
+                id: history
                 anchors.fill: parent
                 anchors.margins: 12
-                antialiasing: true
-
-                onPaint: {
-                    var ctx = getContext("2d");
-                    var w = width;
-                    var h = height;
-                    ctx.reset();
-
-                    var grad = ctx.createLinearGradient(0, 0, 0, h);
-                    grad.addColorStop(0, "#11141b");
-                    grad.addColorStop(1, "#05070a");
-                    ctx.fillStyle = grad;
-                    ctx.fillRect(0, 0, w, h);
-
-                    var cpu = logParser.cpuHistory();
-                    var ram = logParser.ramHistory();
-                    var temp = logParser.tempHistory();
-
-                    var n = cpu.length;
-                    if (ram.length < n) n = ram.length;
-                    if (temp.length < n) n = temp.length;
-
-                    if (n <= 1)
-                        return;
-
-                    var maxPoints = 150;
-                    var startIndex = 0;
-                    if (n > maxPoints)
-                        startIndex = n - maxPoints;
-
-                    var maxVal = 100;
-                    for (var i = startIndex; i < n; ++i) {
-                        if (cpu[i] > maxVal) maxVal = cpu[i];
-                        if (ram[i] > maxVal) maxVal = ram[i];
-                        if (temp[i] > maxVal) maxVal = temp[i];
-                    }
 
-                    var pad = 30;
-                    var plotW = w - 2 * pad;
-                    var plotH = h - 2 * pad;
-
-                    // grid
-                    ctx.strokeStyle = "#242a36";
-                    ctx.lineWidth = 1;
-                    ctx.beginPath();
-                    for (var gy = 0; gy <= 4; ++gy) {
-                        var yy = pad + gy * plotH / 4;
-                        ctx.moveTo(pad, yy);
-                        ctx.lineTo(w - pad, yy);
-                    }
-                    for (var gx = 0; gx <= 6; ++gx) {
-                        var xx = pad + gx * plotW / 6;
-                        ctx.moveTo(xx, pad);
-                        ctx.lineTo(xx, h - pad);
-                    }
-                    ctx.stroke();
+                readonly property real pad: 30
+                // at least 100 so percentages keep their scale; TEMP may go up to 120
+                readonly property real scaleMax: Math.max(100,
+                                                          logParser.cpuHistory.maxValue,
+                                                          logParser.ramHistory.maxValue,
+                                                          logParser.tempHistory.maxValue)
+                // samples across the width; the wheel zooms out to everything that is kept
+                property real span: 150
+                onSpanChanged: {
+                    logParser.cpuHistory.span = span;
+                    logParser.ramHistory.span = span;
+                    logParser.tempHistory.span = span;
+                }
 
-                    function xForIndex(idx) {
-                        var pos = idx - startIndex;
-                        var visibleCount = n - startIndex;
-                        if (visibleCount <= 1) visibleCount = 2;
-                        return pad + (plotW * pos) / (visibleCount - 1);
-                    }
+                // background, grid and legend only change with the size
+                Canvas {
+                    id: historyCanvas
+                    anchors.fill: parent
+                    antialiasing: true
 
-                    function yForValue(v) {
-                        var ratio = v / maxVal;
-                        return (h - pad) - ratio * plotH;
-                    }
+                    onWidthChanged: requestPaint()
+                    onHeightChanged: requestPaint()
 
-                    function drawSeries(data, color) {
-                        ctx.strokeStyle = color;
-                        ctx.lineWidth = 2;
+                    onPaint: {
+                        var ctx = getContext("2d");
+                        var w = width;
+                        var h = height;
+                        ctx.reset();
+
+                        var grad = ctx.createLinearGradient(0, 0, 0, h);
+                        grad.addColorStop(0, "#11141b");
+                        grad.addColorStop(1, "#05070a");
+                        ctx.fillStyle = grad;
+                        ctx.fillRect(0, 0, w, h);
+
+                        var pad = history.pad;
+                        var plotW = w - 2 * pad;
+                        var plotH = h - 2 * pad;
+
+                        // grid
+                        ctx.strokeStyle = "#242a36";
+                        ctx.lineWidth = 1;
                         ctx.beginPath();
-                        ctx.moveTo(xForIndex(startIndex), yForValue(data[startIndex]));
-                        for (var i = startIndex + 1; i < n; ++i) {
-                            ctx.lineTo(xForIndex(i), yForValue(data[i]));
+                        for (var gy = 0; gy <= 4; ++gy) {
+                            var yy = pad + gy * plotH / 4;
+                            ctx.moveTo(pad, yy);
+                            ctx.lineTo(w - pad, yy);
+                        }
+                        for (var gx = 0; gx <= 6; ++gx) {
+                            var xx = pad + gx * plotW / 6;
+                            ctx.moveTo(xx, pad);
+                            ctx.lineTo(xx, h - pad);
                         }
                         ctx.stroke();
-                    }
 
-                    drawSeries(cpu,  "#ff5252");
-                    drawSeries(ram,  "#4caf50");
-                    drawSeries(temp, "#42a5f5");
+                        // legend
+                        ctx.font = "11px sans-serif";
+                        ctx.textBaseline = "middle";
+                        ctx.textAlign = "left";
+
+                        var lx = pad;
+                        var ly = pad - 10;
 
-                    // legend
-                    ctx.font = "11px sans-serif";
-                    ctx.textBaseline = "middle";
-                    ctx.textAlign = "left";
+                        ctx.fillStyle = "#ff5252";
+                        ctx.fillRect(lx, ly - 4, 14, 3);
+                        ctx.fillStyle = "#dfe5f0";
+                        ctx.fillText("CPU", lx + 20, ly);
 
-                    var lx = pad;
-                    var ly = pad - 10;
+                        ctx.fillStyle = "#4caf50";
+                        ctx.fillRect(lx + 70, ly - 4, 14, 3);
+                        ctx.fillStyle = "#dfe5f0";
+                        ctx.fillText("RAM", lx + 90, ly);
 
-                    ctx.fillStyle = "#ff5252";
-                    ctx.fillRect(lx, ly - 4, 14, 3);
-                    ctx.fillStyle = "#dfe5f0";
-                    ctx.fillText("CPU", lx + 20, ly);
+                        ctx.fillStyle = "#42a5f5";
+                        ctx.fillRect(lx + 140, ly - 4, 14, 3);
+                        ctx.fillStyle = "#dfe5f0";
+                        ctx.fillText("TEMP", lx + 160, ly);
+                    }
+                }
 
-                    ctx.fillStyle = "#4caf50";
-                    ctx.fillRect(lx + 70, ly - 4, 14, 3);
-                    ctx.fillStyle = "#dfe5f0";
-                    ctx.fillText("RAM", lx + 90, ly);
+                // the series are scene-graph line strips, one min/max pair per pixel column
+                Item {
+                    id: plot
+                    anchors.fill: parent
+                    anchors.margins: history.pad
 
-                    ctx.fillStyle = "#42a5f5";
-                    ctx.fillRect(lx + 140, ly - 4, 14, 3);
-                    ctx.fillStyle = "#dfe5f0";
-                    ctx.fillText("TEMP", lx + 160, ly);
+                    HistoryChart {
+                        anchors.fill: parent
+                        model: logParser.cpuHistory
+                        color: "#ff5252"
+                        maxValue: history.scaleMax
+                    }
+                    HistoryChart {
+                        anchors.fill: parent
+                        model: logParser.ramHistory
+                        color: "#4caf50"
+                        maxValue: history.scaleMax
+                    }
+                    HistoryChart {
+                        anchors.fill: parent
+                        model: logParser.tempHistory
+                        color: "#42a5f5"
+                        maxValue: history.scaleMax
+                    }
                 }
-            }
-        }
-    }
 
-    // repaint history when C++ says history changed
-    Connections {
-        target: logParser
-        function onHistoryChanged() {
-            historyCanvas.requestPaint();
-        }
-    }
+                Text {
+                    anchors.right: parent.right
+                    anchors.rightMargin: history.pad
+                    anchors.bottom: parent.bottom
+                    anchors.bottomMargin: 8
+                    color: "#777f8b"
+                    font.pixelSize: 11
+                    text: qsTr("last %1 samples (scroll to zoom)").arg(Math.round(history.span))
+                }
 
-    // small periodic refresh for smoothness
-    Timer {
-        interval: 100
-        running: true
-        repeat: true
-        onTriggered: historyCanvas.requestPaint()
+                MouseArea {
+                    anchors.fill: parent
+                    acceptedButtons: Qt.NoButton
+                    onWheel: {
+                        var kept = Math.max(150, logParser.cpuHistory.available);
+                        var next = wheel.angleDelta.y > 0 ? history.span / 2 : history.span * 2;
+                        history.span = Math.max(16, Math.min(kept, next));
+                    }
+                }
+            }
+        }
     }
 
     // ===== SPLASH SCREEN =====
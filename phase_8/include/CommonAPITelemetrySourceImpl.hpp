@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 #include <CommonAPI/CommonAPI.hpp>
 
 #include "ITelemetrySource.hpp"   
@@ -14,20 +18,69 @@ class CommonAPITelemetrySourceImpl : public ITelemetrySource {
 public:
     static CommonAPITelemetrySourceImpl& getInstance();
 
-    
+    // EVENT subscribes to the server's telemetryUpdate broadcast (default),
+    // BATCH to the typed telemetryBatch broadcast (N samples per message),
+    // REQUEST polls with requestDataAsync: every intervalMs it tops up to maxOutstanding calls in flight
+    enum class Mode { EVENT, BATCH, REQUEST };
+    void setMode(Mode mode);
+    void setRequestOptions(size_t maxOutstanding, int timeoutMs, int intervalMs);
+
     bool OpenSource() override;
     bool ReadSource(std::string &out) override;
 
+    // event/batch mode: an eventfd signalled for every queued notification;
+    // request mode: an epoll fd over that eventfd and the request timerfd
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view> &out) override;
+
+    uint64_t getDroppedCount() const;
+    uint64_t getFailedCount() const;   // REQUEST mode: calls that timed out or failed
+    bool isServerAvailable() const;
+
 private:
     CommonAPITelemetrySourceImpl() = default;
-    ~CommonAPITelemetrySourceImpl() override = default;
+    ~CommonAPITelemetrySourceImpl() override;
 
     CommonAPITelemetrySourceImpl(const CommonAPITelemetrySourceImpl&) = delete;
     CommonAPITelemetrySourceImpl& operator=(const CommonAPITelemetrySourceImpl&) = delete;
 
+    static std::string format(const v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &snap);
+    void onTelemetryUpdate(const v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &snap);
+    void onTelemetryBatch(const v1::v1::logger::methods::TelemetryTypes::TelemetrySampleBatch &samples);
+    void enqueue(std::string record);  // caller holds queueMtx_
+    void onAvailability(CommonAPI::AvailabilityStatus status);
+    void onRequestDone(const CommonAPI::CallStatus &status,
+                       const v1::v1::logger::methods::TelemetryTypes::TelemetrySnapshot &snap);
+    bool openRequestTimer();
+    bool startRequestRounds();   // first round now, then every requestIntervalMs_
+    bool requestRoundDue();   // consumes the timer expirations
+    void issueRequests();
+    void wake();
+    size_t drain(std::vector<std::string_view> &out);
+
     std::shared_ptr<CommonAPI::Runtime> runtime_;
     std::shared_ptr<v1::v1::logger::methods::loggingProxy<>> proxy_;
 
     bool ready_ = false;
     std::mutex mtx_;
+
+    static constexpr size_t MAX_QUEUED = 1024;
+    Mode mode_ = Mode::EVENT;
+    int eventFd_ = -1;
+    mutable std::mutex queueMtx_;
+    std::deque<std::string> queue_;        // filled by the CommonAPI dispatch thread
+    std::vector<std::string> delivered_;   // backs the views of the last ReadAvailable
+    uint64_t dropped_ = 0;
+
+    // availability is tracked from the proxy status event instead of spinning on isAvailable()
+    std::atomic<bool> available_{false};
+    static constexpr int MIN_REQUEST_INTERVAL_MS = 10;
+    size_t maxOutstanding_ = 4;
+    int requestIntervalMs_ = 250;
+    int requestTimerFd_ = -1;
+    int requestEpollFd_ = -1;
+    std::atomic<size_t> outstanding_{0};
+    std::atomic<uint64_t> failed_{0};
+    CommonAPI::CallInfo callInfo_{1000};
 };
\ No newline at end of file
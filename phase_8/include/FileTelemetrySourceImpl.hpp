@@ -1,19 +1,53 @@
 #pragma once
 
 #include "ITelemetrySource.hpp"
+#include "recordframer.hpp"
 #include "safefile.hpp"
 #include <string>
 #include <memory>
+#include <sys/types.h>
 
 class FileTelemetrySourceImpl : public ITelemetrySource {
 private:
     std::string path_;
     std::unique_ptr<safefile> file_;
-    std::string leftover_; 
+    RecordFramer framer_;
+    std::vector<std::string_view> batch_; // records not yet handed out by ReadSource
+    size_t next_ = 0;
+    bool eof_ = false;
+
+    // follow mode (tail -F): inotify wakes us on change, EOF is not the end
+    bool follow_ = false;
+    std::string offsetPath_;  // "<inode> <offset>" of the last consumed byte, survives restarts
+    int epollFd_ = -1;        // inotify + kick, exposed to the reactor
+    int inotifyFd_ = -1;
+    int kickFd_ = -1;         // eventfd: more data is already waiting in the file
+    int fileWatch_ = -1;
+    int offsetFd_ = -1;
+    ino_t inode_ = 0;
+    off_t readPos_ = 0;
+
+    bool openFollowed(bool restoreOffset);
+    void watchFile();
+    void drainEvents();
+    void kick();
+    void persistOffset();
+    ReadStatus readFollowed(std::vector<std::string_view>& out);
     
 public:
     explicit FileTelemetrySourceImpl(const std::string& path);
+    // follow: keep reading as the file grows, across truncation and rotation;
+    // offsetPath: where the read offset is persisted (empty = path + ".offset")
+    FileTelemetrySourceImpl(const std::string& path, bool follow, const std::string& offsetPath = "");
+    ~FileTelemetrySourceImpl() override;
+
+    FileTelemetrySourceImpl(const FileTelemetrySourceImpl&) = delete;
+    FileTelemetrySourceImpl& operator=(const FileTelemetrySourceImpl&) = delete;
     
     bool OpenSource() override;
     bool ReadSource(std::string& out) override;
+
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view>& out) override;
 };
@@ -1,15 +1,45 @@
 #pragma once 
 
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class ReadStatus
+{
+    OK,          // records were appended, there may be more
+    WOULD_BLOCK, // nothing available right now
+    CLOSED       // source is exhausted or disconnected
+};
+
 class ITelemetrySource
 {
 private:
+    std::string lastRecord_; // backs the view handed out by the default ReadAvailable
 
 public:
     ITelemetrySource() = default;
     virtual bool OpenSource() = 0;
     virtual bool ReadSource(std::string & out) = 0;
+
+    // Readiness API used by IngestionReactor. A source exposing an fd is
+    // switched to non-blocking mode and read when epoll reports it readable;
+    // sources returning -1 are read once per reactor tick instead.
+    virtual int getFd() const { return -1; }
+    virtual bool setNonBlocking() { return false; }
+
+    // Appends the complete records available now without blocking on a pollable fd.
+    // The views stay valid until the next ReadAvailable/ReadSource call on this source.
+    virtual ReadStatus ReadAvailable(std::vector<std::string_view> & out)
+    {
+        if (!ReadSource(lastRecord_))
+        {
+            return ReadStatus::CLOSED;
+        }
+        out.push_back(lastRecord_);
+        return ReadStatus::OK;
+    }
+
     virtual ~ITelemetrySource() = default;
 };
 
-
@@ -7,5 +7,7 @@ class Ilogsink
 public:
     Ilogsink() = default;            
     virtual void write(const logmessage& str) = 0;
+    // called by LogManager once per drained batch; sinks that buffer override it
+    virtual void flush() {}
     virtual ~Ilogsink() = default;   
 };
\ No newline at end of file
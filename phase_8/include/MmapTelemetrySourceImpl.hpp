@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ITelemetrySource.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bulk replay of a recorded telemetry file. The file is mapped read-only,
+// split into newline-aligned chunks that are indexed in parallel, and handed
+// out as zero-copy views. With a replay rate, every line is expected to start
+// with its original epoch-ms timestamp ("<ms> <payload>") and is released at
+// rate x the original pace; the timestamp is stripped from the record.
+// getFd() is a timerfd armed for the next due line (or immediately while
+// lines are ready), so the reactor sleeps between paced lines.
+class MmapTelemetrySourceImpl : public ITelemetrySource {
+private:
+    std::string path_;
+    double replayRate_;   // 0 = as fast as possible
+    size_t threads_;
+    size_t batchSize_;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+
+    std::vector<std::vector<std::string_view>> chunks_; // per-chunk line index, in file order
+    size_t chunk_ = 0;
+    size_t line_ = 0;
+
+    int timerFd_ = -1;
+    bool paced_ = false;
+    int64_t firstTs_ = 0;
+    std::chrono::steady_clock::time_point start_;
+
+    void indexLines();
+    bool nextLine(std::string_view& line);
+    void unmap();
+    void armTimer(std::chrono::steady_clock::time_point due); // epoch = right away
+
+public:
+    explicit MmapTelemetrySourceImpl(const std::string& path,
+                                     double replayRate = 0.0,
+                                     size_t threads = 0,      // 0 = hardware concurrency
+                                     size_t batchSize = 4096);
+    ~MmapTelemetrySourceImpl() override;
+
+    MmapTelemetrySourceImpl(const MmapTelemetrySourceImpl&) = delete;
+    MmapTelemetrySourceImpl& operator=(const MmapTelemetrySourceImpl&) = delete;
+
+    bool OpenSource() override;
+    bool ReadSource(std::string& out) override;
+
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view>& out) override;
+
+    size_t getRecordCount() const;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ITelemetrySource.hpp"
+#include "shmring.hpp"
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Reads a shared-memory ring published by the server (TELEMETRY_SHM) or by
+// another logger's shm sink. Each record is handed out as
+// "@<epoch ms> <SOURCE> <label> <value>" ("@<epoch ms> <SOURCE> <value>" for an
+// aggregate value), the same text the SOME/IP batch path uses for collector
+// metrics, so every line is stamped with the time the value was sampled. The reactor
+// waits on the ShmRingWaiter's eventfd, which fires when the writer notifies,
+// so an idle ring costs no polling. A ring that disappears (writer restarted)
+// is re-attached.
+class ShmTelemetrySourceImpl : public ITelemetrySource {
+private:
+    ShmRingReader reader_;
+    ShmRingWaiter waiter_;
+    size_t batchSize_;
+    std::vector<ShmRecord> records_;
+    std::string text_;                                  // backs the views handed out
+    std::vector<std::pair<size_t, size_t>> spans_;      // offset, length in text_
+    std::chrono::steady_clock::time_point lastAttach_;
+
+    bool reattach();
+
+public:
+    explicit ShmTelemetrySourceImpl(const std::string& name, size_t batchSize = 4096);
+
+    bool OpenSource() override;
+    bool ReadSource(std::string& out) override;
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view>& out) override;
+
+    uint64_t getLostCount() const;   // records the writer overwrote before we read them
+};
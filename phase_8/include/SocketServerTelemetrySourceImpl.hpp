@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ITelemetrySource.hpp"
+#include "recordframer.hpp"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+struct ConnectionStats
+{
+    int fd = -1;
+    pid_t pid = 0;           // peer process, from SO_PEERCRED
+    uint64_t bytes = 0;
+    uint64_t records = 0;
+    uint64_t framingErrors = 0;
+};
+
+// Listening Unix-domain socket that accepts many local agents. Every
+// connection is multiplexed on an internal epoll set whose fd is what the
+// IngestionReactor polls, so any number of agents costs one reactor slot.
+class SocketServerTelemetrySourceImpl : public ITelemetrySource {
+private:
+    struct Connection
+    {
+        ConnectionStats stats;
+        RecordFramer framer; // reassembly of partial frames
+    };
+
+    std::string socketPath_;
+    FramingMode framing_;
+    size_t maxConnections_;
+    int listenFd_ = -1;
+    int epollFd_ = -1;
+    std::unordered_map<int, Connection> connections_;
+    std::vector<Connection> retired_;  // closed this cycle; their buffers still back handed-out views
+    std::deque<std::string> pending_;  // records not yet handed out by ReadSource
+
+    uint64_t accepted_ = 0;
+    uint64_t closed_ = 0;
+
+    void acceptAll();
+    void closeConnection(int fd);
+    static void printStats(const ConnectionStats& stats, const char* state);
+    bool readConnection(Connection& conn, std::vector<std::string_view>& out);
+
+public:
+    explicit SocketServerTelemetrySourceImpl(const std::string& socketPath,
+                                             FramingMode framing = FramingMode::NEWLINE,
+                                             size_t maxConnections = 1024);
+    ~SocketServerTelemetrySourceImpl() override;
+
+    SocketServerTelemetrySourceImpl(const SocketServerTelemetrySourceImpl&) = delete;
+    SocketServerTelemetrySourceImpl& operator=(const SocketServerTelemetrySourceImpl&) = delete;
+
+    bool OpenSource() override;
+    bool ReadSource(std::string& out) override;
+
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view>& out) override;
+
+    std::vector<ConnectionStats> getConnectionStats() const;
+    uint64_t getAcceptedCount() const;
+    uint64_t getClosedCount() const;
+
+    // accept/close totals and the stats of connections still open, e.g. at shutdown
+    void printSummary() const;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ITelemetrySource.hpp"
+#include "recordframer.hpp"
 #include "safesocket.hpp"
 #include <string>
 #include <memory>
@@ -9,11 +10,19 @@ class SocketTelemetrySourceImpl : public ITelemetrySource {
 private:
     std::string socketPath_;
     std::unique_ptr<SafeSocket> socket_;
+    RecordFramer framer_;                 // peers send '\n'-terminated records
+    std::vector<std::string_view> batch_; // records not yet handed out by ReadSource
+    size_t next_ = 0;
+    bool closed_ = false;
+    bool nonBlocking_ = false;
     
 public:
     explicit SocketTelemetrySourceImpl(const std::string& socketPath);
     
     bool OpenSource() override;
     bool ReadSource(std::string& out) override;
-};
 
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view>& out) override;
+};
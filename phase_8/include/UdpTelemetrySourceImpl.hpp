@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ITelemetrySource.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// Connectionless agents: every datagram carries one or more '\n' separated
+// records. Datagrams are pulled with recvmmsg into a preallocated slot ring,
+// many per syscall. With one shard the socket itself is handed to the
+// IngestionReactor; with more, SO_REUSEPORT sockets are drained by receiver
+// threads into a shared inbox and an eventfd is handed out instead.
+class UdpTelemetrySourceImpl : public ITelemetrySource {
+private:
+    struct Receiver
+    {
+        int fd = -1;
+        std::vector<char> slots;     // BATCH x slotSize datagram buffers, reused every batch
+        std::vector<mmsghdr> msgs;
+        std::vector<iovec> iov;
+        std::vector<char> control;   // per-message cmsg space for SO_RXQ_OVFL
+        std::atomic<uint32_t> kernelDrops{0}; // socket's cumulative overflow counter
+    };
+
+    std::string address_;
+    size_t shards_;
+    size_t slotSize_;
+    std::vector<std::unique_ptr<Receiver>> receivers_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+    bool nonBlocking_ = false;
+
+    // sharded mode: receiver threads append to inbox_, the reactor swaps it out;
+    // records before inboxHead_ were dropped to keep the inbox bounded
+    int wakeFd_ = -1;
+    std::mutex inboxMutex_;
+    std::string inbox_;
+    std::vector<std::pair<uint32_t, uint32_t>> inboxRecords_; // offset, length in inbox_
+    size_t inboxHead_ = 0;
+    size_t inboxLiveBytes_ = 0;
+    std::atomic<uint64_t> inboxDropped_{0};
+    std::string outbox_;
+    std::vector<std::pair<uint32_t, uint32_t>> outboxRecords_;
+
+    std::deque<std::string> pending_;  // records not yet handed out by ReadSource
+
+    std::atomic<uint64_t> datagrams_{0};
+    std::atomic<uint64_t> truncated_{0};
+
+    bool openReceiver(Receiver& rx, bool reusePort, bool blocking);
+    int receiveBatch(Receiver& rx, int flags);
+    template <typename Fn>
+    void forEachRecord(Receiver& rx, int count, Fn&& fn);
+    void receiverLoop(Receiver& rx);
+    void pushInbox(std::string_view record);   // caller holds inboxMutex_
+    void stop();
+
+public:
+    static constexpr size_t BATCH = 64;
+    static constexpr size_t MAX_INBOX_RECORDS = 65536;
+    static constexpr size_t MAX_INBOX_BYTES = 4 << 20;
+
+    // address is "host:port" or "[ipv6]:port"; shards > 1 enables SO_REUSEPORT receiver threads
+    explicit UdpTelemetrySourceImpl(const std::string& address,
+                                    size_t shards = 1,
+                                    size_t slotSize = 2048);
+    ~UdpTelemetrySourceImpl() override;
+
+    UdpTelemetrySourceImpl(const UdpTelemetrySourceImpl&) = delete;
+    UdpTelemetrySourceImpl& operator=(const UdpTelemetrySourceImpl&) = delete;
+
+    bool OpenSource() override;
+    bool ReadSource(std::string& out) override;
+
+    int getFd() const override;
+    bool setNonBlocking() override;
+    ReadStatus ReadAvailable(std::vector<std::string_view>& out) override;
+
+    uint64_t getDatagramCount() const;
+    uint64_t getTruncatedCount() const;   // datagrams longer than slotSize
+    uint64_t getDroppedCount() const;     // dropped by the kernel, from SO_RXQ_OVFL
+    uint64_t getInboxDroppedCount() const; // sharded mode: oldest records dropped while the reactor lagged
+
+    void printSummary() const;
+};
@@ -5,13 +5,24 @@
 #include "logmanager.hpp"
 #include "consolesink.hpp"
 #include "filesink.hpp"
+#include "binarysink.hpp"
+#include "shmsink.hpp"
 #include "formatter.hpp"
 #include "policies.hpp"
 #include "CommonAPITelemetrySourceImpl.hpp"
+#include "FileTelemetrySourceImpl.hpp"
+#include "SocketTelemetrySourceImpl.hpp"
+#include "SocketServerTelemetrySourceImpl.hpp"
+#include "MmapTelemetrySourceImpl.hpp"
+#include "UdpTelemetrySourceImpl.hpp"
+#include "ShmTelemetrySourceImpl.hpp"
+#include "ingestionreactor.hpp"
 #include "ringbuffer.hpp"
 
 #include <atomic>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 class YouTalkingToMe {
 public:
@@ -30,12 +41,22 @@ private:
     filesink cpuFileSink;
     filesink ramFileSink;
     filesink tempFileSink;
+    std::unique_ptr<binarysink> binaryFileSink;   // only created when enabled
+    std::unique_ptr<shmsink> shmSink;             // only created when a ring name is configured
     LogManager logger;
 
-    ITelemetrySource& source;
+    std::vector<std::unique_ptr<ITelemetrySource>> ownedSources; // file/socket; SOME/IP is a singleton
+    std::vector<bool> coreAlerting;   // per core: above CpuPolicy::WARNING on the last sample
 
     void setupLogger();
     void runConsumer();
     void runProducer();
-    void pushMeasurement(const std::string& policyName, const std::string& valueStr);
+    ITelemetrySource* makeSource(const SourceConfig& sc);
+    void handleRecord(const SourceConfig& sc, std::string_view raw);
+    // timeMs: the sample's epoch ms from an "@<ms> " record prefix, 0 = now
+    void pushMeasurement(const std::string& policyName, const std::string& valueStr, int64_t timeMs = 0);
+    void pushMetric(const SourceConfig& sc, std::string_view source, const std::string& label, float value,
+                    int64_t timeMs);
+    void pushCoreMeasurement(const SourceConfig& sc, size_t core, const int (&values)[5], int64_t timeMs);
+    bool shouldLogCore(const SourceConfig& sc, size_t core, int total);
 };
\ No newline at end of file
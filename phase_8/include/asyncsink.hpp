@@ -0,0 +1,58 @@
+#pragma once
+#include "Ilogsink.hpp"
+#include "logmessage.hpp"
+#include "ringbuffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+enum class OverflowPolicy
+{
+    BLOCK,       // producer waits up to blockTimeout for room, then drops until the sink moves again
+    DROP_OLDEST, // overwrite the oldest queued message
+    DROP_NEW     // discard the incoming message
+};
+
+struct AsyncSinkOptions
+{
+    size_t queueCapacity = 1024;
+    OverflowPolicy overflow = OverflowPolicy::BLOCK;
+    std::chrono::milliseconds blockTimeout{200};
+};
+
+// Wraps a sink with its own bounded queue and worker thread, so a slow
+// sink only ever delays itself. The wrapped sink is only touched by the worker.
+class asyncsink : public Ilogsink
+{
+private:
+    Ilogsink *target;
+    OverflowPolicy overflow;
+    std::chrono::milliseconds blockTimeout;
+    RingBuffer<logmessage> queue;
+    std::mutex mtx;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    bool stopping{false};
+    bool stalled{false};   // a BLOCK wait timed out; cleared when the worker takes a batch
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> delivered{0};
+    std::thread worker;
+
+    void loop();
+
+public:
+    asyncsink(Ilogsink *target, const AsyncSinkOptions &options = {});
+    ~asyncsink();
+
+    asyncsink(const asyncsink &) = delete;
+    asyncsink &operator=(const asyncsink &) = delete;
+
+    void write(const logmessage &msg) override;
+    void flush() override;
+
+    uint64_t getDroppedCount() const;
+    uint64_t getDeliveredCount() const;
+};
\ No newline at end of file
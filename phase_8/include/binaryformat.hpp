@@ -0,0 +1,243 @@
+#pragma once
+// On-disk layout of the binary telemetry format written by binarysink and
+// read by BinaryTelemetryReader. Integers are stored in host (little-endian) order.
+//
+//   file    := header block* [index tail]
+//   header  := "TLMB" u16 version u16 reserved
+//   block   := "TLMK" u32 payloadBytes u32 rows i64 minTs i64 maxTs payload
+//   payload := timestamps: zigzag-varint first value, then zigzag-varint deltas (ms)
+//              dictionaries for name, context, severity: u8 count, (u8 len, bytes)*
+//              codes: rows u8 name codes, then rows u8 context codes, then rows u8 severity codes
+//              values: u32 byte length, Gorilla XOR bit stream, XORed per context
+//              repeats: varint count, then (varint row delta, varint repeats) per dedup
+//                       summary row; the row delta counts from the previous summary row
+//   index   := (u64 offset, u32 rows, i64 minTs, i64 maxTs) per block
+//   tail    := u64 indexOffset, u32 blockCount, "TLMI"
+//
+// The index and tail are only written on a clean close. Each block header
+// repeats its index entry, so a file cut short by a crash is read by walking
+// the block headers instead; a torn last block is ignored. A block holds at
+// most MAX_DICTIONARY distinct values per string column; the writer closes it
+// early rather than overflow a dictionary.
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace binaryformat
+{
+    constexpr char FILE_MAGIC[4]  = {'T', 'L', 'M', 'B'};
+    constexpr char INDEX_MAGIC[4] = {'T', 'L', 'M', 'I'};
+    constexpr char BLOCK_MAGIC[4] = {'T', 'L', 'M', 'K'};
+    constexpr uint16_t VERSION = 3;
+    constexpr size_t HEADER_SIZE = 8;
+    constexpr size_t BLOCK_HEADER_SIZE = 4 + 4 + 4 + 8 + 8;
+    constexpr size_t INDEX_ENTRY_SIZE = 8 + 4 + 8 + 8;
+    constexpr size_t TAIL_SIZE = 8 + 4 + 4;
+    constexpr size_t MAX_DICTIONARY = 255;
+
+    template <typename T>
+    inline void put(std::string &out, T value)
+    {
+        char raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        out.append(raw, sizeof(T));
+    }
+
+    template <typename T>
+    inline T get(const char *in)
+    {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        return value;
+    }
+
+    inline uint64_t zigzag(int64_t v)
+    {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t v)
+    {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    inline void putVarint(std::string &out, uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<char>(v));
+    }
+
+    // returns false on truncated input
+    inline bool getVarint(const char *&in, const char *end, uint64_t &v)
+    {
+        v = 0;
+        for (int shift = 0; in < end && shift < 64; shift += 7)
+        {
+            uint8_t byte = static_cast<uint8_t>(*in++);
+            v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    class BitWriter
+    {
+    private:
+        std::string &out;
+        uint64_t acc = 0;
+        int used = 0;
+
+    public:
+        explicit BitWriter(std::string &out) : out(out) {}
+
+        void write(uint64_t bits, int count)
+        {
+            for (int i = count - 1; i >= 0; --i)
+            {
+                acc = (acc << 1) | ((bits >> i) & 1);
+                if (++used == 8)
+                {
+                    out.push_back(static_cast<char>(acc));
+                    acc = 0;
+                    used = 0;
+                }
+            }
+        }
+
+        void finish()
+        {
+            if (used > 0)
+            {
+                out.push_back(static_cast<char>(acc << (8 - used)));
+                acc = 0;
+                used = 0;
+            }
+        }
+    };
+
+    class BitReader
+    {
+    private:
+        const uint8_t *data;
+        size_t size;
+        size_t pos = 0; // in bits
+
+    public:
+        BitReader(const char *data, size_t size)
+            : data(reinterpret_cast<const uint8_t *>(data)), size(size) {}
+
+        bool read(int count, uint64_t &bits)
+        {
+            if (pos + static_cast<size_t>(count) > size * 8)
+            {
+                return false;
+            }
+            bits = 0;
+            for (int i = 0; i < count; ++i, ++pos)
+            {
+                bits = (bits << 1) | ((data[pos >> 3] >> (7 - (pos & 7))) & 1);
+            }
+            return true;
+        }
+    };
+
+    // Gorilla-style XOR compression of a float series
+    struct XorState
+    {
+        uint32_t prev = 0;
+        int leading = -1; // window of the previous meaningful bits, -1 = none yet
+        int trailing = 0;
+        bool first = true;
+    };
+
+    inline void encodeXor(BitWriter &bw, XorState &st, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        if (st.first)
+        {
+            bw.write(bits, 32);
+            st.prev = bits;
+            st.first = false;
+            return;
+        }
+
+        uint32_t x = bits ^ st.prev;
+        st.prev = bits;
+        if (x == 0)
+        {
+            bw.write(0, 1);
+            return;
+        }
+        bw.write(1, 1);
+
+        int leading = __builtin_clz(x);
+        int trailing = __builtin_ctz(x);
+        if (leading > 31)
+            leading = 31;
+
+        if (st.leading >= 0 && leading >= st.leading && trailing >= st.trailing)
+        {
+            bw.write(0, 1);
+            bw.write(x >> st.trailing, 32 - st.leading - st.trailing);
+            return;
+        }
+
+        int meaningful = 32 - leading - trailing;
+        bw.write(1, 1);
+        bw.write(static_cast<uint64_t>(leading), 5);
+        bw.write(static_cast<uint64_t>(meaningful - 1), 5);
+        bw.write(x >> trailing, meaningful);
+        st.leading = leading;
+        st.trailing = trailing;
+    }
+
+    inline bool decodeXor(BitReader &br, XorState &st, float &value)
+    {
+        uint64_t bits = 0;
+        if (st.first)
+        {
+            if (!br.read(32, bits))
+                return false;
+            st.prev = static_cast<uint32_t>(bits);
+            st.first = false;
+        }
+        else
+        {
+            uint64_t flag = 0;
+            if (!br.read(1, flag))
+                return false;
+            if (flag)
+            {
+                uint64_t control = 0;
+                if (!br.read(1, control))
+                    return false;
+                if (control)
+                {
+                    uint64_t leading = 0, meaningful = 0;
+                    if (!br.read(5, leading) || !br.read(5, meaningful))
+                        return false;
+                    st.leading = static_cast<int>(leading);
+                    st.trailing = 32 - st.leading - static_cast<int>(meaningful + 1);
+                }
+                else if (st.leading < 0)
+                {
+                    return false;
+                }
+                if (!br.read(32 - st.leading - st.trailing, bits))
+                    return false;
+                st.prev ^= static_cast<uint32_t>(bits << st.trailing);
+            }
+        }
+        std::memcpy(&value, &st.prev, sizeof(value));
+        return true;
+    }
+}
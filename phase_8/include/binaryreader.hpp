@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct TelemetryRecord
+{
+    int64_t timestampMs;
+    float value;
+    std::string_view name;     // valid only during the callback
+    std::string_view context;
+    std::string_view severity;
+    uint32_t repeats;          // > 0 for a dedup summary: identical records up to timestampMs it stands for
+};
+
+// Reads files written by binarysink. Only the footer index is loaded up
+// front (or, for a file whose writer died, rebuilt from the block headers);
+// scan() reads and decodes just the blocks overlapping the range.
+class BinaryTelemetryReader
+{
+private:
+    struct IndexEntry
+    {
+        uint64_t offset;
+        uint64_t size;
+        uint32_t rows;
+        int64_t minTs;
+        int64_t maxTs;
+    };
+
+    int fd = -1;
+    std::vector<IndexEntry> index;
+    std::string block; // reused read buffer
+    std::vector<std::pair<uint64_t, uint32_t>> repeatRows; // row, repeat count of the block being decoded
+
+    bool loadIndex();
+    bool loadFooter(uint64_t fileSize);
+    void scanBlockHeaders(uint64_t fileSize);
+    bool decodeBlock(const IndexEntry &entry, int64_t fromMs, int64_t toMs,
+                     const std::function<void(const TelemetryRecord &)> &fn, size_t &matched);
+
+public:
+    explicit BinaryTelemetryReader(const std::string &path);
+    ~BinaryTelemetryReader();
+
+    BinaryTelemetryReader(const BinaryTelemetryReader &) = delete;
+    BinaryTelemetryReader &operator=(const BinaryTelemetryReader &) = delete;
+
+    bool isOpen() const;
+    size_t getBlockCount() const;
+    uint64_t getRecordCount() const;
+
+    // calls fn for every record with fromMs <= timestamp <= toMs, returns how many matched
+    size_t scan(int64_t fromMs, int64_t toMs, const std::function<void(const TelemetryRecord &)> &fn);
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include "Ilogsink.hpp"
+#include "logmessage.hpp"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Writes telemetry as columnar blocks (see binaryformat.hpp). A block is
+// encoded and flushed once rowsPerBlock messages are collected; the block
+// index footer is written when the sink is destroyed. A dedup summary
+// ("previous message repeated N times") is stored as one row carrying its
+// repeat count, so a constant metric does not leave a gap in range scans.
+class binarysink : public Ilogsink
+{
+private:
+    struct IndexEntry
+    {
+        uint64_t offset;
+        uint32_t rows;
+        int64_t minTs;
+        int64_t maxTs;
+    };
+
+    // dictionary-encoded string column
+    struct Dictionary
+    {
+        std::vector<std::string> values;
+        std::vector<uint8_t> codes;
+        bool fits(const std::string &value) const;   // known, or room for one more
+        uint8_t encode(const std::string &value);    // only after fits()
+        void clear();
+    };
+
+    std::unique_ptr<std::ofstream> ptr;
+    uint64_t offset = 0;
+    size_t rowsPerBlock;
+
+    std::vector<int64_t> timestamps;
+    std::vector<float> values;
+    std::vector<std::pair<uint32_t, uint32_t>> repeats;   // row, repeat count of dedup summaries
+    Dictionary names;
+    Dictionary contexts;
+    Dictionary severities;
+    std::vector<IndexEntry> index;
+
+    std::string lastTime;        // seconds part of the last timestamp text; most rows share it,
+    int64_t lastSecondMs = 0;    // so they reuse its parse and only add their milliseconds
+    int64_t lastTimeMs = 0;
+
+    std::string block;         // reused encoding buffer
+
+    int64_t parseTimeMs(const std::string &time);
+    void encodeBlock();
+    void writeRaw(const std::string &bytes);
+
+public:
+    explicit binarysink(const std::string &file, size_t rowsPerBlock = 4096);
+    ~binarysink();
+
+    binarysink(const binarysink &) = delete;
+    binarysink &operator=(const binarysink &) = delete;
+
+    void write(const logmessage &msg) override;
+};
@@ -1,19 +1,54 @@
 // config.hpp
 #pragma once
+#include <map>
 #include <string>
 #include <vector>
 
-struct AppConfig {
-    std::string sourceType;          // "someip" | "file" | "socket"
+struct SourceConfig {
+    std::string type;                 // "someip" | "file" | "socket" | "socket_server" | "mmap" | "udp" | "shm"
+    std::string path;                 // for file/socket/socket_server/mmap; ring name for shm
+    std::string framing{"newline"};   // for socket_server: "newline" | "length_prefixed"
+    bool follow{false};               // for file: keep following appends/rotation (tail -F)
+    std::string offsetFile;           // for file+follow: persisted read offset, default <path>.offset
+    double replayRate{0.0};           // for mmap: 0 = full speed, otherwise x original pace
+    std::string address;              // for udp: "host:port", default 127.0.0.1:5140
+    int shards{1};                    // for udp: SO_REUSEPORT receiver threads (1 = read on the reactor)
     std::vector<std::string> mapping; // for someip: e.g. ["cpu","temp","ram"]
-    std::string policy;             // for file/socket: "cpu"|"ram"|"temp"
+    std::string mode{"event"};        // for someip: "event" | "batch" (subscribe) | "request" (poll requestData)
+    int outstanding{4};               // for someip+request: requestDataAsync calls kept in flight
+    int timeoutMs{1000};              // for someip+request: per-call timeout
+    int requestMs{250};               // for someip+request: period of the request rounds (at least 10 ms)
+    std::string perCore{"alerts"};    // for someip+batch and shm: "off" | "alerts" (cores crossing CpuPolicy::WARNING) | "all"
+    std::string policy;               // for file/socket: "cpu"|"ram"|"temp"|"disk"|"net"|"pressure"|"proc"
+};
+
+struct AppConfig {
+    std::vector<SourceConfig> sources; // all driven by one IngestionReactor
 
     bool sinkConsole{true};
     bool sinkCpuFile{true};
     bool sinkRamFile{true};
     bool sinkTempFile{true};
+    bool sinkBinaryFile{false};   // columnar telemetry.tlm, see binaryformat.hpp
+    std::string sinkShm;          // shared-memory ring name for local readers (GUI), empty = off
+
+    // per-sink queue + worker so a slow sink cannot throttle the others
+    bool asyncSinks{true};
+    size_t asyncQueueSize{1024};
+    std::string asyncOverflow{"block"}; // "block" | "drop_oldest" | "drop_new"
+    int asyncBlockMs{200};              // longest a "block" sink may hold up the consumer
+    // opt-in per sink, keyed like "sinks" ("console", "cpu_file", ...); others use asyncOverflow
+    std::map<std::string, std::string> asyncSinkOverflow;
+
+    // dedup / rate limit / sampling stage in LogManager
+    bool filterDedup{false};
+    double infoPerSec{0};      // 0 = unlimited
+    double warningPerSec{0};
+    double criticalPerSec{0};
+    double rateBurst{10};
+    double infoSampleRate{1.0};
 
-    int parseMs{0};
+    int parseMs{10};   // poll interval of sources without an fd, see IngestionReactor
     int logMs{0};
 };
 
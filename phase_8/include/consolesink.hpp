@@ -1,11 +1,30 @@
 #pragma once
 #include <iostream>
+#include <string>
 #include "Ilogsink.hpp"
 #include "logmessage.hpp"
 class consolesink : public Ilogsink
 {
+private:
+    std::string pending;        // rendered batch, written with one write() per flush
+    bool colors;
+    size_t maxPendingBytes;     // 0 = never drop
+    int outFd{-1};              // non-blocking descriptor for stdout, see openStdout(); -1 once it failed
+    bool outIsSocket{false};    // shares fd 1's file description, so use send(MSG_DONTWAIT)
+    bool backlogged{false};     // stdout took less than the whole batch on the last flush
+    size_t dropped{0};
+    size_t droppedSinceReport{0};
+
+    void openStdout();
+    ssize_t writeSome(const char* data, size_t size);
+    void appendLine(const logmessage& msg);
+
 public:
-    consolesink() = default;
-    ~consolesink() = default;
+    // colors enabled only when stdout is a terminal
+    consolesink();
+    explicit consolesink(bool useColors, size_t maxPendingBytes = 64 * 1024);
+    ~consolesink();
     void write(const logmessage& str) override;
+    void flush() override;
+    size_t getDroppedCount() const;
 };
\ No newline at end of file
@@ -1,19 +1,24 @@
 #pragma once
 #include "logmessage.hpp"
 #include "logtype.hpp"
+#include <cstdint>
+#include <ctime>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <chrono>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
 #include <magic_enum/magic_enum.hpp>
 
+// Every format function takes the sample's wall-clock time in epoch ms;
+// 0 stamps the message with the time it is formatted at.
 template <typename Policy>
 class LogFormatter
 {
 public:
-static std::optional<logmessage> formatDataToLogMsg(const std::string &raw)
+static std::optional<logmessage> formatDataToLogMsg(const std::string &raw, int64_t timeMs = 0)
 {
     auto valOpt = parseFloat(raw);
     if (!valOpt)
@@ -33,7 +38,7 @@ static std::optional<logmessage> formatDataToLogMsg(const std::string &raw)
     std::string contextStr  = std::string(magic_enum::enum_name(Policy::context));
 
     std::string description = msgDescription(val);
-    std::string timestamp = currentTimeStamp();
+    std::string timestamp = timeStamp(timeMs);
 
     logmessage msg(
         "TelemetryApp",
@@ -42,10 +47,79 @@ static std::optional<logmessage> formatDataToLogMsg(const std::string &raw)
         severityStr,
         description
     );
+    msg.setValue(val);
 
     return msg;
 }
 
+// labelled collector value, e.g. "DISK sda usage: 42.5%"
+static std::optional<logmessage> formatMetricToLogMsg(const std::string &label, float val, int64_t timeMs = 0)
+{
+    if (val < 0 || val > Policy::maxValue)
+        return std::nullopt;
+
+    std::ostringstream ss;
+    ss << magic_enum::enum_name(Policy::context) << " " << label << " usage: " << val << Policy::unit;
+
+    logmessage msg(
+        "TelemetryApp",
+        timeStamp(timeMs),
+        std::string(magic_enum::enum_name(Policy::context)),
+        std::string(magic_enum::enum_name(Policy::inferSeverity(val))),
+        ss.str()
+    );
+    msg.setValue(val);
+
+    return msg;
+}
+
+// one line per core, e.g. "CPU3 usage: 97% (user 90%, system 5%, iowait 2%, steal 0%)"
+static std::optional<logmessage> formatCoreToLogMsg(size_t core, float total, float user,
+                                                    float system, float iowait, float steal,
+                                                    int64_t timeMs = 0)
+{
+    if (total < 0 || total > Policy::maxValue)
+        return std::nullopt;
+
+    std::ostringstream ss;
+    ss << magic_enum::enum_name(Policy::context) << core << " usage: " << total << Policy::unit
+       << " (user " << user << Policy::unit
+       << ", system " << system << Policy::unit
+       << ", iowait " << iowait << Policy::unit
+       << ", steal " << steal << Policy::unit << ")";
+
+    logmessage msg(
+        "TelemetryApp",
+        timeStamp(timeMs),
+        std::string(magic_enum::enum_name(Policy::context)),
+        std::string(magic_enum::enum_name(Policy::inferSeverity(total))),
+        ss.str()
+    );
+    msg.setValue(total);
+
+    return msg;
+}
+
+// total only, e.g. "CPU3 usage: 97%", when the breakdown did not travel (shared-memory ring)
+static std::optional<logmessage> formatCoreToLogMsg(size_t core, float total, int64_t timeMs = 0)
+{
+    if (total < 0 || total > Policy::maxValue)
+        return std::nullopt;
+
+    std::ostringstream ss;
+    ss << magic_enum::enum_name(Policy::context) << core << " usage: " << total << Policy::unit;
+
+    logmessage msg(
+        "TelemetryApp",
+        timeStamp(timeMs),
+        std::string(magic_enum::enum_name(Policy::context)),
+        std::string(magic_enum::enum_name(Policy::inferSeverity(total))),
+        ss.str()
+    );
+    msg.setValue(total);
+
+    return msg;
+}
 
 private:
     static std::string msgDescription(float val)
@@ -55,14 +129,22 @@ private:
         return ss.str();
     }
 
-    static std::string currentTimeStamp()
+    // local time with milliseconds, so samples taken faster than 1 Hz keep their order
+    static std::string timeStamp(int64_t timeMs)
     {
-        auto now = std::chrono::system_clock::now();
-        auto in_time_t = std::chrono::system_clock::to_time_t(now);
+        if (timeMs <= 0)
+        {
+            timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+        std::time_t seconds = static_cast<std::time_t>(timeMs / 1000);
+        std::tm tm{};
+        localtime_r(&seconds, &tm);
 
-        std::ostringstream ss;
-        ss << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+        char buf[32];
+        size_t n = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+        std::snprintf(buf + n, sizeof(buf) - n, ".%03d", static_cast<int>(timeMs % 1000));
+        return buf;
     }
 
     static std::optional<float> parseFloat(const std::string &raw)
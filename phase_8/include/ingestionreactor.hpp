@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ITelemetrySource.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// Multiplexes many telemetry sources on the calling thread with epoll.
+// Records from every source go to that source's handler, which is the
+// entry point of the shared formatting stage.
+class IngestionReactor
+{
+public:
+    using RecordHandler = std::function<void(std::string_view record)>; // view valid only during the call
+
+private:
+    struct Entry
+    {
+        ITelemetrySource *source;
+        RecordHandler handler;
+        bool pollable;
+        bool active;
+    };
+
+    static constexpr uint64_t WAKE_TOKEN = ~uint64_t{0};
+    static constexpr int MIN_POLL_INTERVAL_MS = 1;
+
+    int epollFd;
+    int wakeFd;
+    int pollIntervalMs;
+    std::vector<Entry> entries;
+    std::vector<std::string_view> records; // reused per read
+    size_t activeCount{0};
+    std::atomic<bool> stopping{false};
+
+    bool service(size_t idx); // true if the source returned records and may have more
+    void deactivate(size_t idx);
+
+public:
+    // pollIntervalMs: how often idle sources without an fd are read (at least 1 ms);
+    // a source that just returned records is read again straight away
+    explicit IngestionReactor(int pollIntervalMs = 10);
+    ~IngestionReactor();
+
+    IngestionReactor(const IngestionReactor &) = delete;
+    IngestionReactor &operator=(const IngestionReactor &) = delete;
+
+    // opens the source and registers it; the source must outlive the reactor
+    bool addSource(ITelemetrySource &source, RecordHandler handler);
+
+    // runs until every source is closed or stop() is called
+    void run();
+
+    // thread-safe, wakes run() up
+    void stop();
+
+    size_t getActiveCount() const;
+};
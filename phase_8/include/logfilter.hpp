@@ -0,0 +1,73 @@
+#pragma once
+#include "logmessage.hpp"
+#include "logtype.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+struct LogFilterOptions
+{
+    static constexpr size_t SEVERITY_COUNT = magic_enum::enum_count<SeverityLvl_enum>();
+
+    // collapse consecutive identical messages of a context into one "repeated N times" line
+    bool dedup = false;
+    size_t dedupMaxRepeat = 100; // long runs still report every dedupMaxRepeat duplicates
+
+    // token bucket per context and severity, indexed by SeverityLvl_enum; 0 = unlimited
+    std::array<double, SEVERITY_COUNT> ratePerSec{};
+    double burst = 10.0;
+
+    // probability that an INFO message is kept; WARNING and CRITICAL always pass
+    double infoSampleRate = 1.0;
+
+    bool enabled() const;
+};
+
+// Pipeline stage in front of LogManager's buffer: dedup -> sampling -> rate limit.
+// Dedup only folds duplicates of a line that got past sampling and rate limiting.
+class LogFilter
+{
+private:
+    static constexpr size_t CONTEXT_SLOTS = magic_enum::enum_count<TelemetrySrc_enum>() + 1; // last slot: unknown context
+
+    struct TokenBucket
+    {
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point last{};
+        bool primed = false;
+    };
+
+    struct ContextState
+    {
+        std::optional<logmessage> last;
+        size_t repeats = 0;
+        std::array<TokenBucket, LogFilterOptions::SEVERITY_COUNT> buckets{};
+    };
+
+    LogFilterOptions options;
+    std::array<ContextState, CONTEXT_SLOTS> contexts{};
+    std::minstd_rand rng;
+    std::uniform_real_distribution<double> coin{0.0, 1.0};
+    uint64_t suppressed = 0;
+
+    static logmessage repeatSummary(const logmessage& last, size_t repeats);
+    bool takeToken(TokenBucket& bucket, double rate);
+
+public:
+    explicit LogFilter(const LogFilterOptions& options = {});
+
+    // appends whatever should be logged for msg (possibly a summary, possibly nothing)
+    void process(const logmessage& msg, std::vector<logmessage>& out);
+
+    // emits the summaries of runs that are still open, e.g. at shutdown
+    void drain(std::vector<logmessage>& out);
+
+    // true for the "previous message repeated N times" lines made by process()/drain(),
+    // which carry their count in logmessage::getRepeatCount()
+    static bool isRepeatSummary(const logmessage& msg);
+
+    uint64_t getSuppressedCount() const;
+};
\ No newline at end of file
@@ -1,15 +1,49 @@
 // logmanager.hpp
 #pragma once
 #include "Ilogsink.hpp"
+#include "asyncsink.hpp"
+#include "logfilter.hpp"
 #include "logmessage.hpp"
+#include "logtype.hpp"
 #include "ringbuffer.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
+// Which messages a sink receives. Default-constructed routes accept everything.
+struct SinkRoute
+{
+    std::optional<TelemetrySrc_enum> context;              // nullopt = any context
+    SeverityLvl_enum minSeverity = SeverityLvl_enum::INFO; // floor; INFO lets everything through
+    std::string name;                                      // empty = any logger name
+};
+
 class LogManager
 {
+public:
+    static constexpr size_t MAX_SINKS = 64;
+
 private:
+    static constexpr size_t CONTEXT_SLOTS  = magic_enum::enum_count<TelemetrySrc_enum>() + 1; // last slot: unknown context
+    static constexpr size_t SEVERITY_SLOTS = magic_enum::enum_count<SeverityLvl_enum>();
+
     RingBuffer<logmessage> messageBuffer;
     std::vector <Ilogsink*> currentSink;
+    std::vector<SinkRoute> routes;
+    std::vector<std::unique_ptr<asyncsink>> asyncSinks; // owned wrappers, parallel to currentSink (null = synchronous)
+
+    LogFilter filter;
+    bool filtering{false};
+    std::vector<logmessage> filtered; // scratch output of the filter stage
+
+    // routeTable[context][severity] = bitmap of sink indices that accept the pair
+    std::array<std::array<uint64_t, SEVERITY_SLOTS>, CONTEXT_SLOTS> routeTable{};
+
+    void compileRoutes();
+    void dispatch(const logmessage& msg);
 
 public:
     LogManager( size_t bufferCapacity = 10);
@@ -24,11 +58,19 @@ public:
     
     ~LogManager() = default;
 
-    void addSink(Ilogsink* sink);
+    void addSink(Ilogsink* sink, const SinkRoute& route = {});
+    // sink gets its own bounded queue and worker thread
+    void addAsyncSink(Ilogsink* sink, const AsyncSinkOptions& options, const SinkRoute& route = {});
    
 
+    // dedup / sampling / rate limiting applied in log() before buffering
+    void setFilter(const LogFilterOptions& options);
+
     void log(const logmessage& msg);
 
+    // queues the "repeated N times" summaries of still-open duplicate runs
+    void flushSuppressed();
+
     void flush();
 
     void clear();
@@ -36,18 +78,32 @@ public:
     size_t getMessageCount() const;
 
     bool isEmpty() const;
+
+    // messages dropped by each sink's queue, indexed like the sinks were added (0 for synchronous sinks)
+    std::vector<uint64_t> getDroppedCounts() const;
+
+    uint64_t getSuppressedCount() const;
 };
 
 class logmanagerbuilder
 {
 private:
     size_t bufferCapacity;
-    std::vector<Ilogsink*> sinks;
+    struct SinkEntry
+    {
+        Ilogsink* sink;
+        SinkRoute route;
+        std::optional<AsyncSinkOptions> async;
+    };
+    std::vector<SinkEntry> sinks;
+    LogFilterOptions filterOptions;
 public:
     logmanagerbuilder(size_t bufferCapacity );
     logmanagerbuilder& setBufferCapacity(size_t capacity);
+    logmanagerbuilder& setFilter(const LogFilterOptions& options);
 
-    logmanagerbuilder& addSink(Ilogsink* sink);
+    logmanagerbuilder& addSink(Ilogsink* sink, const SinkRoute& route = {});
+    logmanagerbuilder& addAsyncSink(Ilogsink* sink, const AsyncSinkOptions& options, const SinkRoute& route = {});
 
     LogManager build();
 };
\ No newline at end of file
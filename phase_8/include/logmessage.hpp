@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -10,6 +11,8 @@ private:
     std::string context;
     std::string severity;
     std::string text;
+    float value{0.0f};   // raw measurement behind text, for binary sinks
+    uint32_t repeats{0}; // > 0 only on a dedup summary: the duplicates it stands for
 
 public:
     // Constructors
@@ -28,12 +31,16 @@ public:
     std::string getContext() const;
     std::string getSeverity() const;
     std::string getText() const;
+    float getValue() const;
+    uint32_t getRepeatCount() const;
     
     void setName(const std::string& n);
     void setTime(const std::string& t);
     void setContext(const std::string& c);
     void setSeverity(const std::string& s);
     void setText(const std::string& txt);
+    void setValue(float v);
+    void setRepeatCount(uint32_t n);
     
   
    friend std::ostream& operator<<(std::ostream& os ,const logmessage& msg );
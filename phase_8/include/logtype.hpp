@@ -18,5 +18,9 @@ enum class SeverityLvl_enum {
 enum class TelemetrySrc_enum {
     CPU,
     TEMP,
-    RAM
+    RAM,
+    DISK,       // per-device utilisation, server DiskCollector
+    NET,        // per-interface throughput, server NetCollector
+    PRESSURE,   // PSI stall share, server PressureCollector
+    PROC        // per-PID CPU, server ProcessCollector
 };
@@ -43,6 +43,74 @@ struct TempPolicy
     static constexpr std::string_view unit = "°C";
     static constexpr TelemetrySrc_enum context = TelemetrySrc_enum::TEMP;
 
+    static constexpr SeverityLvl_enum inferSeverity(float val)
+    {
+        if (val > CRITICAL)
+            return SeverityLvl_enum::CRITICAL;
+        if (val > WARNING)
+            return SeverityLvl_enum::WARNING;
+        return SeverityLvl_enum::INFO;
+    }
+};
+struct DiskPolicy
+{
+    static constexpr float maxValue = 100.0f;          // % of the interval with I/O in flight
+    static constexpr float WARNING  = 70.0f;
+    static constexpr float CRITICAL = 90.0f;
+    static constexpr std::string_view unit = "%";
+    static constexpr TelemetrySrc_enum context = TelemetrySrc_enum::DISK;
+
+    static constexpr SeverityLvl_enum inferSeverity(float val)
+    {
+        if (val > CRITICAL)
+            return SeverityLvl_enum::CRITICAL;
+        if (val > WARNING)
+            return SeverityLvl_enum::WARNING;
+        return SeverityLvl_enum::INFO;
+    }
+};
+struct NetPolicy
+{
+    static constexpr float maxValue = 400000.0f;       // rx + tx, 400 Gbit/s
+    static constexpr float WARNING  = 800.0f;          // thresholds sized for a 1 Gbit/s link
+    static constexpr float CRITICAL = 950.0f;
+    static constexpr std::string_view unit = " Mbit/s";
+    static constexpr TelemetrySrc_enum context = TelemetrySrc_enum::NET;
+
+    static constexpr SeverityLvl_enum inferSeverity(float val)
+    {
+        if (val > CRITICAL)
+            return SeverityLvl_enum::CRITICAL;
+        if (val > WARNING)
+            return SeverityLvl_enum::WARNING;
+        return SeverityLvl_enum::INFO;
+    }
+};
+struct PressurePolicy
+{
+    static constexpr float maxValue = 100.0f;          // % of the interval some task was stalled
+    static constexpr float WARNING  = 10.0f;
+    static constexpr float CRITICAL = 40.0f;
+    static constexpr std::string_view unit = "%";
+    static constexpr TelemetrySrc_enum context = TelemetrySrc_enum::PRESSURE;
+
+    static constexpr SeverityLvl_enum inferSeverity(float val)
+    {
+        if (val > CRITICAL)
+            return SeverityLvl_enum::CRITICAL;
+        if (val > WARNING)
+            return SeverityLvl_enum::WARNING;
+        return SeverityLvl_enum::INFO;
+    }
+};
+struct ProcPolicy
+{
+    static constexpr float maxValue = 102400.0f;       // top-style, 100 per core
+    static constexpr float WARNING  = 80.0f;
+    static constexpr float CRITICAL = 95.0f;
+    static constexpr std::string_view unit = "%";
+    static constexpr TelemetrySrc_enum context = TelemetrySrc_enum::PROC;
+
     static constexpr SeverityLvl_enum inferSeverity(float val)
     {
         if (val > CRITICAL)
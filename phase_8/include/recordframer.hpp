@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+enum class FramingMode
+{
+    NEWLINE,        // one record per '\n'-terminated line
+    LENGTH_PREFIXED // u32 big-endian length, then the record bytes
+};
+
+// Reusable read buffer that splits a byte stream into records without
+// copying them. Usage per read cycle:
+//   reclaim();  read into tail()/tailSpace();  commit(n);  split(out);
+// Views handed out by split()/takePartial() stay valid until the next reclaim().
+class RecordFramer
+{
+private:
+    FramingMode mode;
+    std::vector<char> buffer;
+    size_t begin = 0;       // first byte not yet handed out
+    size_t end = 0;         // one past the last byte read
+    bool skipping = false;  // newline mode: discarding an oversized line
+    uint64_t framingErrors = 0;
+
+public:
+    static constexpr size_t MAX_FRAME = 64 * 1024;
+
+    explicit RecordFramer(FramingMode mode = FramingMode::NEWLINE, size_t capacity = 64 * 1024);
+
+    // moves the partial record to the front (growing up to MAX_FRAME if it fills the buffer)
+    void reclaim();
+
+    char *tail();
+    size_t tailSpace() const;
+    void commit(size_t n);
+
+    // appends a view per complete record; false after an unrecoverable framing error
+    bool split(std::vector<std::string_view> &out);
+
+    // newline mode at EOF: hands out an unterminated last line
+    bool takePartial(std::vector<std::string_view> &out);
+
+    // drops everything buffered, e.g. after the underlying file was truncated
+    void clear();
+
+    size_t buffered() const;
+    uint64_t getFramingErrors() const;
+};
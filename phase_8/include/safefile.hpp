@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <memory>
+#include <sys/types.h>
 class safefile
 {
 private:
@@ -16,5 +17,7 @@ public:
     safefile& operator=(safefile&& other) noexcept;
 
     int Read(char * buffer , int buffer_size);
+    off_t Seek(off_t offset, int whence);
     bool isOpen()const;
+    int getFd()const;
 };
@@ -21,6 +21,8 @@ public:
     bool Connect();
     
     bool isOpen() const;
+
+    bool setNonBlocking();
     
     ssize_t Read(char* buffer, size_t count);
         
@@ -0,0 +1,176 @@
+#pragma once
+#include "logtype.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Shared-memory telemetry channel. One process (the server or the logger)
+// creates a POSIX shm segment holding a fixed ring of records; any number of
+// local readers (the logger, the Qt GUI) map it read-only and poll it with a
+// private cursor, so readers never slow the writer down or each other.
+//
+// Every slot is guarded by a sequence number (odd while it is being written,
+// 2*index+2 once record `index` is complete). A reader copies the slot and
+// checks the sequence before and after; a mismatch means the writer lapped it
+// and the record is counted as lost instead of being returned torn.
+//
+// Readers that want to sleep until there is news wait on the header's
+// wakeSeq futex word, which the writer bumps in notify() once per batch;
+// ShmRingWaiter turns that into an eventfd for epoll or a Qt notifier.
+//
+// Segment layout: ShmRingHeader, then `capacity` 64-byte slots.
+
+// one value as it travels through the ring; label is not NUL-terminated
+struct ShmRecord
+{
+    uint64_t timestampMs = 0;  // wall clock, epoch ms
+    float value = 0.0f;
+    uint8_t context = 0;       // TelemetrySrc_enum index
+    uint8_t severity = 0;      // SeverityLvl_enum index
+    uint8_t labelLen = 0;
+    uint8_t reserved = 0;
+    char label[32] = {};       // empty for the aggregate value, core number for per-core CPU,
+                               // device/interface/sensor for collector metrics
+
+    static ShmRecord make(uint64_t timestampMs, TelemetrySrc_enum context, SeverityLvl_enum severity,
+                          std::string_view label, float value);
+
+    std::string_view getLabel() const { return std::string_view(label, labelLen); }
+    TelemetrySrc_enum getContext() const;
+    SeverityLvl_enum getSeverity() const;
+};
+static_assert(sizeof(ShmRecord) == 48, "ShmRecord is copied as six 64-bit words");
+
+struct ShmRingHeader
+{
+    static constexpr uint32_t MAGIC = 0x544c4d52;   // "TLMR"
+    static constexpr uint16_t VERSION = 2;
+
+    std::atomic<uint32_t> magic;   // stored last, so a reader never sees a half-initialised header
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t capacity;
+    std::atomic<uint32_t> wakeSeq;   // futex word, bumped by ShmRingWriter::notify()
+    alignas(64) std::atomic<uint64_t> head;   // records ever published
+};
+
+struct ShmRingSlot
+{
+    static constexpr size_t WORDS = sizeof(ShmRecord) / sizeof(uint64_t);
+
+    alignas(64) std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> words[WORDS];
+};
+static_assert(sizeof(ShmRingSlot) == 64, "one slot per cache line");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring words must be lock-free to live in shared memory");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "wakeSeq is used as a futex word");
+
+// Creates (replacing any stale segment of the same name) and publishes. Single writer.
+class ShmRingWriter
+{
+private:
+    std::string name;
+    size_t mapSize = 0;
+    ShmRingHeader *header = nullptr;
+    ShmRingSlot *slots = nullptr;
+    uint32_t capacity = 0;
+    uint64_t next = 0;
+
+public:
+    explicit ShmRingWriter(const std::string &name, uint32_t capacity = 4096);
+    ~ShmRingWriter();   // unlinks the segment and wakes waiters; mapped readers notice through isStale()
+
+    ShmRingWriter(const ShmRingWriter &) = delete;
+    ShmRingWriter &operator=(const ShmRingWriter &) = delete;
+
+    bool isOpen() const { return header != nullptr; }
+    void publish(const ShmRecord &record);
+    // wakes sleeping readers; one futex syscall, so call it once per batch of publish()
+    void notify();
+    const std::string &getName() const { return name; }
+};
+
+class ShmRingReader
+{
+private:
+    std::string name;
+    int fd = -1;
+    size_t mapSize = 0;
+    const ShmRingHeader *header = nullptr;
+    const ShmRingSlot *slots = nullptr;
+    uint32_t capacity = 0;
+    uint64_t cursor = 0;
+    uint64_t lost = 0;
+
+public:
+    explicit ShmRingReader(const std::string &name);
+    ~ShmRingReader();
+
+    ShmRingReader(const ShmRingReader &) = delete;
+    ShmRingReader &operator=(const ShmRingReader &) = delete;
+
+    // maps the segment read-only; with backlog the records still in the ring are returned first
+    bool open(bool backlog = false);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // appends up to max records published since the last call and returns how many
+    size_t read(std::vector<ShmRecord> &out, size_t max = SIZE_MAX);
+
+    // the writer is gone or was restarted with a new segment; close() and open() again
+    bool isStale() const;
+
+    // records overwritten before this reader got to them
+    uint64_t getLostCount() const { return lost; }
+
+    // records ever published, 0 while closed
+    uint64_t getHead() const;
+    // sleeps until the head moves past seenHead, a notify() or timeoutMs; true if the head moved
+    bool waitForWrite(uint64_t seenHead, int timeoutMs) const;
+};
+
+// Turns the writer's futex wake-ups into a pollable eventfd for one consumer.
+// A helper thread maps the ring on its own, sleeps on wakeSeq and signals the
+// eventfd whenever the head has moved. While the ring is missing or stale it
+// signals once per REOPEN_EVERY_MS instead, so the consumer gets to re-attach.
+// The consumer calls clear() before reading the ring and keeps reading it
+// itself; the waiter never touches the consumer's cursor.
+class ShmRingWaiter
+{
+private:
+    static constexpr int WAIT_TIMEOUT_MS = 250;   // bounds how long stop() waits for the thread
+    static constexpr int REOPEN_EVERY_MS = 1000;
+
+    ShmRingReader ring;
+    int eventFd = -1;
+    std::thread thread;
+    std::mutex stopMtx;
+    std::condition_variable stopCv;
+    bool running = false;
+
+    void run();
+
+public:
+    explicit ShmRingWaiter(const std::string &name);
+    ~ShmRingWaiter();
+
+    ShmRingWaiter(const ShmRingWaiter &) = delete;
+    ShmRingWaiter &operator=(const ShmRingWaiter &) = delete;
+
+    bool start();
+    void stop();
+
+    // readable (non-blocking eventfd) while there may be records to read
+    int getFd() const { return eventFd; }
+    void signal();
+    void clear();
+};
+
+// POSIX shm names start with a single '/'
+std::string shmRingName(const std::string &name);
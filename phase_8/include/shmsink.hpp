@@ -0,0 +1,22 @@
+#pragma once
+#include "Ilogsink.hpp"
+#include "logmessage.hpp"
+#include "shmring.hpp"
+#include <string>
+
+// Publishes every message into a shared-memory ring (see shmring.hpp) so local
+// consumers such as the GUI map the values instead of re-parsing the log files.
+// The label is the part of the text between the context and " usage:", e.g.
+// "3" for "CPU3 usage: ..." and "sda" for "DISK sda usage: ...".
+class shmsink : public Ilogsink
+{
+private:
+    ShmRingWriter ring;
+
+public:
+    explicit shmsink(const std::string &name, uint32_t capacity = 4096);
+
+    void write(const logmessage &msg) override;
+    // wakes the ring's readers once per drained batch
+    void flush() override;
+};
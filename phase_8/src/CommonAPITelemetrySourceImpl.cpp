@@ -1,7 +1,12 @@
 #include "CommonAPITelemetrySourceImpl.hpp"
+#include <cerrno>
+#include <charconv>
 #include <iostream>
-#include <thread>
-#include <chrono>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
 using namespace v1::v1::logger::methods;
 
@@ -11,6 +16,66 @@ CommonAPITelemetrySourceImpl& CommonAPITelemetrySourceImpl::getInstance() {
     return instance;
 }
 
+CommonAPITelemetrySourceImpl::~CommonAPITelemetrySourceImpl() {
+    for (int fd : {requestEpollFd_, requestTimerFd_, eventFd_}) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+}
+
+void CommonAPITelemetrySourceImpl::setMode(Mode mode) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!ready_) {
+        mode_ = mode;
+    }
+}
+
+void CommonAPITelemetrySourceImpl::setRequestOptions(size_t maxOutstanding, int timeoutMs, int intervalMs) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!ready_) {
+        maxOutstanding_ = maxOutstanding > 0 ? maxOutstanding : 1;
+        callInfo_ = CommonAPI::CallInfo(timeoutMs > 0 ? timeoutMs : 1000);
+        requestIntervalMs_ = intervalMs > MIN_REQUEST_INTERVAL_MS ? intervalMs : MIN_REQUEST_INTERVAL_MS;
+    }
+}
+
+bool CommonAPITelemetrySourceImpl::openRequestTimer() {
+    // replies wake the eventfd, the timer paces the request rounds; the reactor polls both through one epoll fd
+    requestTimerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    requestEpollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (requestTimerFd_ == -1 || requestEpollFd_ == -1) {
+        return false;
+    }
+
+    if (!startRequestRounds()) {
+        return false;
+    }
+
+    for (int fd : {eventFd_, requestTimerFd_}) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(requestEpollFd_, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CommonAPITelemetrySourceImpl::startRequestRounds() {
+    itimerspec spec{};
+    spec.it_value.tv_nsec = 1;   // first round right away
+    spec.it_interval.tv_sec = requestIntervalMs_ / 1000;
+    spec.it_interval.tv_nsec = static_cast<long>(requestIntervalMs_ % 1000) * 1000000;
+    return timerfd_settime(requestTimerFd_, 0, &spec, nullptr) == 0;
+}
+
+bool CommonAPITelemetrySourceImpl::requestRoundDue() {
+    uint64_t expirations = 0;
+    return read(requestTimerFd_, &expirations, sizeof(expirations)) > 0 && expirations > 0;
+}
+
 
 bool CommonAPITelemetrySourceImpl::OpenSource() {
     std::lock_guard<std::mutex> lock(mtx_);
@@ -30,42 +95,255 @@ bool CommonAPITelemetrySourceImpl::OpenSource() {
         "local",
         "logger.methods.justSendHi"
     );
+    if (!proxy_) {
+        std::cerr << "[CLIENT] Failed to build proxy!\n";
+        return false;
+    }
+
+    eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd_ == -1) {
+        std::cerr << "[CLIENT] eventfd failed\n";
+        return false;
+    }
+    if (mode_ == Mode::REQUEST && !openRequestTimer()) {
+        std::cerr << "[CLIENT] request timer setup failed\n";
+        return false;
+    }
 
+    // the server may come and go; the status event tells us without blocking this thread
     std::cout << "[CLIENT] Waiting for server to become available...\n";
-    while (!proxy_->isAvailable()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    proxy_->getProxyStatusEvent().subscribe(
+        [this](const CommonAPI::AvailabilityStatus &status) {
+            onAvailability(status);
+        });
+
+    if (mode_ == Mode::EVENT) {
+        proxy_->getTelemetryUpdateEvent().subscribe(
+            [this](const TelemetryTypes::TelemetrySnapshot &snap) {
+                onTelemetryUpdate(snap);
+            });
+        std::cout << "[CLIENT] Subscribed to telemetryUpdate\n";
+    } else if (mode_ == Mode::BATCH) {
+        proxy_->getTelemetryBatchEvent().subscribe(
+            [this](const TelemetryTypes::TelemetrySampleBatch &samples) {
+                onTelemetryBatch(samples);
+            });
+        std::cout << "[CLIENT] Subscribed to telemetryBatch\n";
     }
 
-    std::cout << "[CLIENT] Proxy connected!\n";
     ready_ = true;
     return true;
 }
 
+void CommonAPITelemetrySourceImpl::onAvailability(CommonAPI::AvailabilityStatus status) {
+    bool up = (status == CommonAPI::AvailabilityStatus::AVAILABLE);
+    if (available_.exchange(up) == up) {
+        return;
+    }
+    std::cout << (up ? "[CLIENT] Proxy connected!\n" : "[CLIENT] Server went away, waiting...\n");
+    if (up && mode_ == Mode::REQUEST) {
+        // start the next request round right away instead of at the next interval
+        startRequestRounds();
+    } else if (up) {
+        wake();
+    }
+}
 
-bool CommonAPITelemetrySourceImpl::ReadSource(std::string &out) {
-    if (!ready_) {
-        std::cerr << "[CLIENT] Source not opened yet!\n";
-        return false;
+void CommonAPITelemetrySourceImpl::wake() {
+    uint64_t one = 1;
+    (void)!write(eventFd_, &one, sizeof(one));
+}
+
+std::string CommonAPITelemetrySourceImpl::format(const TelemetryTypes::TelemetrySnapshot &snap) {
+    return snap.getCoreLoads() + ";" +
+           std::to_string(snap.getRamUsagePercentage()) + ";" +
+           std::to_string(snap.getTemperatureC());
+}
+
+void CommonAPITelemetrySourceImpl::enqueue(std::string record) {
+    if (queue_.size() >= MAX_QUEUED) {
+        // the consumer fell behind; keep the newest samples
+        queue_.pop_front();
+        ++dropped_;
     }
+    queue_.push_back(std::move(record));
+}
 
-    TelemetryTypes::TelemetrySnapshot snap;
-    CommonAPI::CallStatus callStatus;
+void CommonAPITelemetrySourceImpl::onTelemetryUpdate(const TelemetryTypes::TelemetrySnapshot &snap) {
+    {
+        std::lock_guard<std::mutex> lock(queueMtx_);
+        enqueue(format(snap));
+    }
+    wake();
+}
 
-    proxy_->requestData(callStatus, snap);
+void CommonAPITelemetrySourceImpl::onTelemetryBatch(const TelemetryTypes::TelemetrySampleBatch &samples) {
+    {
+        std::lock_guard<std::mutex> lock(queueMtx_);
+        for (const auto &sample : samples) {
+            const auto &cores = sample.getCoreLoads();
+            unsigned sum = 0;
+            for (const auto &core : cores) {
+                sum += core.getTotal();
+            }
+            unsigned cpu = cores.empty() ? 0 : sum / static_cast<unsigned>(cores.size());
 
-    if (callStatus != CommonAPI::CallStatus::SUCCESS) {
-        std::cerr << "[CLIENT] requestData() failed, status = "
-                  << static_cast<int>(callStatus) << "\n";
-        return false;
+            // "@<epoch ms> " keeps the sampling time, then the same "cpu;temp;ram" layout as the
+            // snapshot records, so the someip mapping still applies, followed by one fixed
+            // "total/user/system/iowait/steal" group per core
+            char buf[32];
+            std::string stamp("@");
+            stamp.append(buf, std::to_chars(buf, buf + sizeof(buf), sample.getTimestampMs()).ptr);
+            stamp.push_back(' ');
+
+            std::string record;
+            record.reserve(stamp.size() + 16 + cores.size() * 20);
+            record.append(stamp);
+            auto append = [&](unsigned value, char sep) {
+                char *p = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+                record.append(buf, p);
+                if (sep) {
+                    record.push_back(sep);
+                }
+            };
+            append(cpu, ';');
+            append(sample.getTemperatureC(), ';');
+            append(sample.getRamUsagePercentage(), 0);
+            for (const auto &core : cores) {
+                record.push_back(';');
+                append(core.getTotal(), '/');
+                append(core.getUser(), '/');
+                append(core.getSystem(), '/');
+                append(core.getIowait(), '/');
+                append(core.getSteal(), 0);
+            }
+            enqueue(std::move(record));
+
+            // collector metrics follow as "@<epoch ms> <SOURCE> <label> <value>" records of their own
+            for (const auto &metric : sample.getMetrics()) {
+                std::string line;
+                line.reserve(stamp.size() + metric.getSource().size() + metric.getLabel().size() + 16);
+                line.append(stamp);
+                line.append(metric.getSource()).push_back(' ');
+                line.append(metric.getLabel()).push_back(' ');
+                char *p = std::to_chars(buf, buf + sizeof(buf), metric.getValue(), std::chars_format::fixed, 1).ptr;
+                line.append(buf, p);
+                enqueue(std::move(line));
+            }
+        }
+    }
+    // one wakeup per message, however many samples it carried
+    wake();
+}
+
+void CommonAPITelemetrySourceImpl::issueRequests() {
+    if (mode_ != Mode::REQUEST || !available_.load()) {
+        return;
     }
+    while (outstanding_.load() < maxOutstanding_) {
+        outstanding_.fetch_add(1);
+        proxy_->requestDataAsync(
+            [this](const CommonAPI::CallStatus &status, const TelemetryTypes::TelemetrySnapshot &snap) {
+                onRequestDone(status, snap);
+            },
+            &callInfo_);
+    }
+}
 
-    const std::string totalCpuStr = snap.getCoreLoads();       
-    const uint32_t ramPercent     = snap.getRamUsagePercentage();
-    const uint16_t tempC          = snap.getTemperatureC();
+void CommonAPITelemetrySourceImpl::onRequestDone(const CommonAPI::CallStatus &status,
+                                                 const TelemetryTypes::TelemetrySnapshot &snap) {
+    outstanding_.fetch_sub(1);
+    if (status != CommonAPI::CallStatus::SUCCESS) {
+        failed_.fetch_add(1);
+        if (status != CommonAPI::CallStatus::NOT_AVAILABLE) {
+            std::cerr << "[CLIENT] requestDataAsync() failed, status = "
+                      << static_cast<int>(status) << "\n";
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMtx_);
+        enqueue(format(snap));
+    }
+    wake();
+}
 
-    out = totalCpuStr + ";" +
-          std::to_string(ramPercent) + ";" +
-          std::to_string(tempC);
+int CommonAPITelemetrySourceImpl::getFd() const {
+    // request mode: readable on a reply or when the next request round is due
+    return mode_ != Mode::REQUEST ? eventFd_ : requestEpollFd_;
+}
 
-    return true;
+bool CommonAPITelemetrySourceImpl::setNonBlocking() {
+    // the eventfd and timerfd are created non-blocking
+    return getFd() != -1;
+}
+
+size_t CommonAPITelemetrySourceImpl::drain(std::vector<std::string_view> &out) {
+    uint64_t count;
+    (void)!read(eventFd_, &count, sizeof(count));
+
+    delivered_.clear();
+    {
+        std::lock_guard<std::mutex> lock(queueMtx_);
+        delivered_.assign(std::make_move_iterator(queue_.begin()),
+                          std::make_move_iterator(queue_.end()));
+        queue_.clear();
+    }
+    for (const auto &record : delivered_) {
+        out.push_back(record);
+    }
+    return delivered_.size();
+}
+
+ReadStatus CommonAPITelemetrySourceImpl::ReadAvailable(std::vector<std::string_view> &out) {
+    if (!ready_) {
+        return ReadStatus::CLOSED;
+    }
+    size_t n = drain(out);
+    if (mode_ == Mode::REQUEST && requestRoundDue()) {
+        issueRequests();
+    }
+    return n > 0 ? ReadStatus::OK : ReadStatus::WOULD_BLOCK;
+}
+
+uint64_t CommonAPITelemetrySourceImpl::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(queueMtx_);
+    return dropped_;
+}
+
+uint64_t CommonAPITelemetrySourceImpl::getFailedCount() const {
+    return failed_.load();
+}
+
+bool CommonAPITelemetrySourceImpl::isServerAvailable() const {
+    return available_.load();
+}
+
+
+bool CommonAPITelemetrySourceImpl::ReadSource(std::string &out) {
+    if (!ready_) {
+        std::cerr << "[CLIENT] Source not opened yet!\n";
+        return false;
+    }
+
+    // wait for the next notification or reply
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(queueMtx_);
+            if (!queue_.empty()) {
+                out = std::move(queue_.front());
+                queue_.pop_front();
+                return true;
+            }
+        }
+        struct pollfd pfd{getFd(), POLLIN, 0};
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+            return false;
+        }
+        uint64_t count;
+        (void)!read(eventFd_, &count, sizeof(count));
+        if (mode_ == Mode::REQUEST && requestRoundDue()) {
+            issueRequests();
+        }
+    }
 }
\ No newline at end of file
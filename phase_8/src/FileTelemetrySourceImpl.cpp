@@ -1,38 +1,216 @@
 #include "FileTelemetrySourceImpl.hpp"
 #include <fcntl.h>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 FileTelemetrySourceImpl::FileTelemetrySourceImpl(const std::string& path)
     : path_(path), file_(nullptr) {}
 
+FileTelemetrySourceImpl::FileTelemetrySourceImpl(const std::string& path, bool follow, const std::string& offsetPath)
+    : path_(path), file_(nullptr), follow_(follow),
+      offsetPath_(offsetPath.empty() ? path + ".offset" : offsetPath) {}
+
+FileTelemetrySourceImpl::~FileTelemetrySourceImpl()
+{
+    for (int fd : {epollFd_, inotifyFd_, kickFd_, offsetFd_}) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+}
+
 bool FileTelemetrySourceImpl::OpenSource()
  {
-    file_ = std::make_unique<safefile>(path_, O_RDONLY);
-    return file_->isOpen();
+    eof_ = false;
+    if (!follow_) {
+        file_ = std::make_unique<safefile>(path_, O_RDONLY);
+        return file_->isOpen();
+    }
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    kickFd_    = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epollFd_   = epoll_create1(EPOLL_CLOEXEC);
+    offsetFd_  = open(offsetPath_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (inotifyFd_ == -1 || kickFd_ == -1 || epollFd_ == -1) {
+        return false;
+    }
+    for (int fd : {inotifyFd_, kickFd_}) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    // the directory watch notices the file being (re)created after rotation
+    auto slash = path_.find_last_of('/');
+    std::string dir = (slash == std::string::npos) ? "." : (slash == 0 ? "/" : path_.substr(0, slash));
+    inotify_add_watch(inotifyFd_, dir.c_str(), IN_CREATE | IN_MOVED_TO);
+
+    // a missing file is fine: we start reading once it appears
+    openFollowed(true);
+    kick();
+    return true;
 }
 
+bool FileTelemetrySourceImpl::openFollowed(bool restoreOffset)
+{
+    auto file = std::make_unique<safefile>(path_, O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (!file->isOpen() || fstat(file->getFd(), &st) != 0) {
+        return false;
+    }
 
-bool FileTelemetrySourceImpl::ReadSource(std::string& out)  {
-        if (!file_ || !file_->isOpen()) return false;
+    file_ = std::move(file);
+    inode_ = st.st_ino;
+    readPos_ = 0;
+    framer_.clear();
+
+    if (restoreOffset && offsetFd_ != -1) {
+        char state[64]{};
+        uintmax_t savedInode = 0, savedOffset = 0;
+        if (pread(offsetFd_, state, sizeof(state) - 1, 0) > 0 &&
+            std::sscanf(state, "%" SCNuMAX " %" SCNuMAX, &savedInode, &savedOffset) == 2 &&
+            savedInode == static_cast<uintmax_t>(st.st_ino) &&
+            savedOffset <= static_cast<uintmax_t>(st.st_size)) {
+            readPos_ = file_->Seek(static_cast<off_t>(savedOffset), SEEK_SET);
+        }
+    }
+
+    watchFile();
+    return true;
+}
+
+void FileTelemetrySourceImpl::watchFile()
+{
+    if (fileWatch_ != -1) {
+        inotify_rm_watch(inotifyFd_, fileWatch_);
+    }
+    fileWatch_ = inotify_add_watch(inotifyFd_, path_.c_str(),
+                                   IN_MODIFY | IN_MOVE_SELF | IN_DELETE_SELF | IN_ATTRIB);
+}
+
+void FileTelemetrySourceImpl::drainEvents()
+{
+    alignas(struct inotify_event) char events[4096];
+    while (read(inotifyFd_, events, sizeof(events)) > 0) {
+        // the events themselves do not matter: every wake-up re-checks size and inode
+    }
+    uint64_t kicks;
+    (void)!read(kickFd_, &kicks, sizeof(kicks));
+}
+
+void FileTelemetrySourceImpl::kick()
+{
+    uint64_t one = 1;
+    (void)!write(kickFd_, &one, sizeof(one));
+}
 
-        char buffer[128]{};
-        int bytesRead = file_->Read(buffer, sizeof(buffer) - 1);
-        if (bytesRead <= 0 && leftover_.empty()) return false;
+void FileTelemetrySourceImpl::persistOffset()
+{
+    if (offsetFd_ == -1) {
+        return;
+    }
+    // fixed width, so the record is overwritten in place without truncating
+    char state[64];
+    int len = std::snprintf(state, sizeof(state), "%20" PRIuMAX " %20" PRIuMAX "\n",
+                            static_cast<uintmax_t>(inode_),
+                            static_cast<uintmax_t>(readPos_ - static_cast<off_t>(framer_.buffered())));
+    (void)!pwrite(offsetFd_, state, static_cast<size_t>(len), 0);
+}
 
-        buffer[bytesRead] = '\0';
-        leftover_ += buffer;
+ReadStatus FileTelemetrySourceImpl::readFollowed(std::vector<std::string_view>& out)
+{
+    drainEvents();
+    framer_.reclaim();
 
-        size_t pos = leftover_.find('\n');
-        if (pos != std::string::npos) {
-            out = leftover_.substr(0, pos);
-            leftover_ = leftover_.substr(pos + 1);
-            return true;
+    if (!file_ || !file_->isOpen()) {
+        if (!openFollowed(false)) {
+            return ReadStatus::WOULD_BLOCK;
         }
+    }
+
+    struct stat st;
+    if (fstat(file_->getFd(), &st) == 0 && st.st_size < readPos_) {
+        // truncated in place (copytruncate rotation): start over
+        readPos_ = file_->Seek(0, SEEK_SET);
+        framer_.clear();
+    }
 
-        if (!leftover_.empty()) {
-            out = leftover_;
-            leftover_.clear();
-            return true;
+    const size_t wanted = framer_.tailSpace();
+    int bytesRead = file_->Read(framer_.tail(), static_cast<int>(wanted));
+    if (bytesRead > 0) {
+        readPos_ += bytesRead;
+        framer_.commit(static_cast<size_t>(bytesRead));
+        framer_.split(out);
+        persistOffset();
+        if (static_cast<size_t>(bytesRead) == wanted) {
+            kick(); // buffer filled up, the file probably has more
         }
+        return ReadStatus::OK;
+    }
 
-        return false;
+    // at EOF of the open file: if the path now names another inode, the file was rotated
+    struct stat current;
+    if (stat(path_.c_str(), &current) == 0 && current.st_ino != inode_) {
+        framer_.takePartial(out);
+        if (openFollowed(false)) {
+            persistOffset();
+            kick();
+        }
+    }
+    return out.empty() ? ReadStatus::WOULD_BLOCK : ReadStatus::OK;
+}
+
+
+bool FileTelemetrySourceImpl::ReadSource(std::string& out)  {
+        while (next_ == batch_.size()) {
+            batch_.clear();
+            next_ = 0;
+            ReadStatus status = ReadAvailable(batch_);
+            if (status == ReadStatus::CLOSED && batch_.empty()) {
+                return false;
+            }
+            if (status == ReadStatus::WOULD_BLOCK) {
+                // follow mode outside the reactor: sleep until inotify fires
+                epoll_event ev;
+                epoll_wait(epollFd_, &ev, 1, -1);
+            }
+        }
+        out.assign(batch_[next_++]);
+        return true;
+    }
+
+int FileTelemetrySourceImpl::getFd() const
+{
+    return follow_ ? epollFd_ : -1;
+}
+
+bool FileTelemetrySourceImpl::setNonBlocking()
+{
+    return follow_ && epollFd_ != -1;
+}
+
+ReadStatus FileTelemetrySourceImpl::ReadAvailable(std::vector<std::string_view>& out)  {
+        if (follow_) return readFollowed(out);
+
+        if (!file_ || !file_->isOpen() || eof_) return ReadStatus::CLOSED;
+
+        // one large read per call; every complete line in it is returned as a view
+        framer_.reclaim();
+        int bytesRead = file_->Read(framer_.tail(), static_cast<int>(framer_.tailSpace()));
+        if (bytesRead <= 0) {
+            eof_ = true;
+            framer_.takePartial(out);
+            return ReadStatus::CLOSED;
+        }
+
+        framer_.commit(static_cast<size_t>(bytesRead));
+        framer_.split(out);
+        return ReadStatus::OK;
     }
\ No newline at end of file
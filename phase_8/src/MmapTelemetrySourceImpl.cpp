@@ -0,0 +1,270 @@
+#include "MmapTelemetrySourceImpl.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <thread>
+#include <unistd.h>
+
+MmapTelemetrySourceImpl::MmapTelemetrySourceImpl(const std::string &path, double replayRate,
+                                                 size_t threads, size_t batchSize)
+    : path_(path),
+      replayRate_(replayRate > 0.0 ? replayRate : 0.0),
+      threads_(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      batchSize_(batchSize > 0 ? batchSize : 1)
+{
+}
+
+MmapTelemetrySourceImpl::~MmapTelemetrySourceImpl()
+{
+    unmap();
+    if (timerFd_ != -1)
+    {
+        close(timerFd_);
+    }
+}
+
+void MmapTelemetrySourceImpl::unmap()
+{
+    if (data_ && size_ > 0)
+    {
+        munmap(const_cast<char *>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool MmapTelemetrySourceImpl::OpenSource()
+{
+    unmap();
+
+    int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0)
+    {
+        void *map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            close(fd);
+            size_ = 0;
+            return false;
+        }
+        // advice values are not flags: each one needs its own call
+        for (int advice : {MADV_SEQUENTIAL, MADV_WILLNEED})
+        {
+            if (madvise(map, size_, advice) != 0)
+            {
+                std::cerr << "[MMAP] madvise(" << advice << ") on " << path_ << " failed: " << std::strerror(errno) << "\n";
+            }
+        }
+        data_ = static_cast<const char *>(map);
+    }
+    close(fd); // the mapping keeps the file alive
+
+    indexLines();
+    chunk_ = 0;
+    line_ = 0;
+    paced_ = false;
+
+    if (timerFd_ == -1)
+    {
+        timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timerFd_ == -1)
+        {
+            return false;
+        }
+    }
+    armTimer(std::chrono::steady_clock::time_point{});
+    return true;
+}
+
+int MmapTelemetrySourceImpl::getFd() const
+{
+    return timerFd_;
+}
+
+bool MmapTelemetrySourceImpl::setNonBlocking()
+{
+    return timerFd_ != -1; // created non-blocking
+}
+
+void MmapTelemetrySourceImpl::armTimer(std::chrono::steady_clock::time_point due)
+{
+    // steady_clock is CLOCK_MONOTONIC; a zero it_value would disarm, so "now" is 1 ns
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(due.time_since_epoch()).count();
+    if (ns <= 0)
+    {
+        ns = 1;
+    }
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+    spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+    timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void MmapTelemetrySourceImpl::indexLines()
+{
+    chunks_.clear();
+    if (size_ == 0)
+    {
+        return;
+    }
+
+    // chunk boundaries are moved forward to the next newline so no line is split
+    const size_t parts = std::min(threads_, std::max<size_t>(1, size_ / (1 << 20)));
+    std::vector<size_t> bounds{0};
+    for (size_t i = 1; i < parts; ++i)
+    {
+        size_t pos = std::max(bounds.back(), size_ * i / parts);
+        const void *nl = std::memchr(data_ + pos, '\n', size_ - pos);
+        pos = nl ? static_cast<size_t>(static_cast<const char *>(nl) - data_) + 1 : size_;
+        bounds.push_back(pos);
+    }
+    bounds.push_back(size_);
+
+    chunks_.resize(bounds.size() - 1);
+    auto indexChunk = [this, &bounds](size_t c)
+    {
+        const char *p = data_ + bounds[c];
+        const char *end = data_ + bounds[c + 1];
+        auto &lines = chunks_[c];
+        while (p < end)
+        {
+            const char *nl = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            const char *stop = nl ? nl : end;
+            const char *trim = (stop > p && stop[-1] == '\r') ? stop - 1 : stop;
+            if (trim > p)
+            {
+                lines.emplace_back(p, static_cast<size_t>(trim - p));
+            }
+            p = stop + 1;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t c = 1; c < chunks_.size(); ++c)
+    {
+        workers.emplace_back(indexChunk, c);
+    }
+    indexChunk(0);
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+bool MmapTelemetrySourceImpl::nextLine(std::string_view &line)
+{
+    while (chunk_ < chunks_.size())
+    {
+        if (line_ < chunks_[chunk_].size())
+        {
+            line = chunks_[chunk_][line_];
+            return true;
+        }
+        ++chunk_;
+        line_ = 0;
+    }
+    return false;
+}
+
+ReadStatus MmapTelemetrySourceImpl::ReadAvailable(std::vector<std::string_view> &out)
+{
+    uint64_t expirations;
+    (void)!read(timerFd_, &expirations, sizeof(expirations));
+
+    // until the next line is due the timer is armed for it, otherwise it fires
+    // straight away so the reactor comes back for the next batch (or the end)
+    std::string_view line;
+    for (size_t n = 0; n < batchSize_; ++n)
+    {
+        if (!nextLine(line))
+        {
+            if (n > 0)
+            {
+                armTimer(std::chrono::steady_clock::time_point{});
+                return ReadStatus::OK;
+            }
+            return ReadStatus::CLOSED;
+        }
+
+        if (replayRate_ > 0.0)
+        {
+            int64_t ts = 0;
+            auto [rest, ec] = std::from_chars(line.data(), line.data() + line.size(), ts);
+            if (ec == std::errc())
+            {
+                if (!paced_)
+                {
+                    paced_ = true;
+                    firstTs_ = ts;
+                    start_ = std::chrono::steady_clock::now();
+                }
+                auto due = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                        std::chrono::duration<double, std::milli>((ts - firstTs_) / replayRate_));
+                if (std::chrono::steady_clock::now() < due)
+                {
+                    armTimer(due);
+                    return n > 0 ? ReadStatus::OK : ReadStatus::WOULD_BLOCK;
+                }
+                size_t skip = static_cast<size_t>(rest - line.data());
+                while (skip < line.size() && (line[skip] == ' ' || line[skip] == '\t' || line[skip] == ','))
+                {
+                    ++skip;
+                }
+                line.remove_prefix(skip);
+            }
+        }
+
+        out.push_back(line);
+        ++line_;
+    }
+    armTimer(std::chrono::steady_clock::time_point{});
+    return ReadStatus::OK;
+}
+
+bool MmapTelemetrySourceImpl::ReadSource(std::string &out)
+{
+    std::vector<std::string_view> one;
+    size_t saved = batchSize_;
+    batchSize_ = 1;
+    ReadStatus status;
+    while ((status = ReadAvailable(one)) == ReadStatus::WOULD_BLOCK)
+    {
+        pollfd pfd{timerFd_, POLLIN, 0};
+        poll(&pfd, 1, -1); // until the next line is due
+    }
+    batchSize_ = saved;
+    if (one.empty())
+    {
+        return false;
+    }
+    out.assign(one.front());
+    return true;
+}
+
+size_t MmapTelemetrySourceImpl::getRecordCount() const
+{
+    size_t total = 0;
+    for (const auto &lines : chunks_)
+    {
+        total += lines.size();
+    }
+    return total;
+}
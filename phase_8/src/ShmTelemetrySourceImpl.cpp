@@ -0,0 +1,116 @@
+#include "ShmTelemetrySourceImpl.hpp"
+#include <charconv>
+#include <thread>
+
+static constexpr auto REATTACH_EVERY = std::chrono::seconds(1);
+
+ShmTelemetrySourceImpl::ShmTelemetrySourceImpl(const std::string &name, size_t batchSize)
+    : reader_(name),
+      waiter_(name),
+      batchSize_(batchSize > 0 ? batchSize : 1)
+{
+}
+
+bool ShmTelemetrySourceImpl::OpenSource()
+{
+    lastAttach_ = std::chrono::steady_clock::now();
+    return reader_.open() && waiter_.start();
+}
+
+int ShmTelemetrySourceImpl::getFd() const
+{
+    return waiter_.getFd();
+}
+
+bool ShmTelemetrySourceImpl::setNonBlocking()
+{
+    // the waiter's eventfd is created non-blocking
+    return getFd() != -1;
+}
+
+bool ShmTelemetrySourceImpl::reattach()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastAttach_ < REATTACH_EVERY)
+    {
+        return false;
+    }
+    lastAttach_ = now;
+    if (!reader_.open())
+    {
+        return false;
+    }
+    std::cout << "[CLIENT] Re-attached to shared memory ring\n";
+    return true;
+}
+
+ReadStatus ShmTelemetrySourceImpl::ReadAvailable(std::vector<std::string_view> &out)
+{
+    waiter_.clear();
+    records_.clear();
+    size_t n = reader_.read(records_, batchSize_);
+    if (n == batchSize_)
+    {
+        waiter_.signal();   // a full batch may have left records behind; come back for them
+    }
+    if (n == 0)
+    {
+        // only an idle ring is checked for a restarted writer, so a busy one costs no syscall
+        if (reader_.isStale())
+        {
+            reattach();
+        }
+        return ReadStatus::WOULD_BLOCK;
+    }
+
+    text_.clear();
+    spans_.clear();
+    char buf[32];
+    for (const ShmRecord &record : records_)
+    {
+        size_t start = text_.size();
+        text_.push_back('@');
+        text_.append(buf, std::to_chars(buf, buf + sizeof(buf), record.timestampMs).ptr).push_back(' ');
+        text_.append(magic_enum::enum_name(record.getContext())).push_back(' ');
+        if (record.labelLen > 0)
+        {
+            text_.append(record.getLabel()).push_back(' ');
+        }
+        char *p = std::to_chars(buf, buf + sizeof(buf), record.value, std::chars_format::fixed, 1).ptr;
+        text_.append(buf, p);
+        spans_.emplace_back(start, text_.size() - start);
+    }
+
+    // views are taken once text_ has stopped growing
+    for (const auto &span : spans_)
+    {
+        out.emplace_back(text_.data() + span.first, span.second);
+    }
+    return ReadStatus::OK;
+}
+
+bool ShmTelemetrySourceImpl::ReadSource(std::string &out)
+{
+    std::vector<std::string_view> one;
+    size_t saved = batchSize_;
+    batchSize_ = 1;
+    while (ReadAvailable(one) == ReadStatus::WOULD_BLOCK)
+    {
+        if (reader_.isOpen())
+        {
+            reader_.waitForWrite(reader_.getHead(), 1000);
+        }
+        else
+        {
+            std::this_thread::sleep_for(REATTACH_EVERY); // no ring to wait on until the writer is back
+        }
+    }
+    batchSize_ = saved;
+    out.assign(one.front());
+    return true;
+}
+
+uint64_t ShmTelemetrySourceImpl::getLostCount() const
+{
+    return reader_.getLostCount();
+}
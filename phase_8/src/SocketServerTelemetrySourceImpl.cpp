@@ -0,0 +1,273 @@
+#include "SocketServerTelemetrySourceImpl.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+SocketServerTelemetrySourceImpl::SocketServerTelemetrySourceImpl(const std::string &socketPath,
+                                                                 FramingMode framing,
+                                                                 size_t maxConnections)
+    : socketPath_(socketPath), framing_(framing), maxConnections_(maxConnections)
+{
+}
+
+SocketServerTelemetrySourceImpl::~SocketServerTelemetrySourceImpl()
+{
+    for (auto &[fd, conn] : connections_)
+    {
+        close(fd);
+    }
+    if (epollFd_ != -1)
+    {
+        close(epollFd_);
+    }
+    if (listenFd_ != -1)
+    {
+        close(listenFd_);
+        unlink(socketPath_.c_str());
+    }
+}
+
+bool SocketServerTelemetrySourceImpl::OpenSource()
+{
+    if (listenFd_ != -1)
+    {
+        return true;
+    }
+
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd_ == -1)
+    {
+        return false;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath_.c_str(), sizeof(addr.sun_path) - 1);
+
+    // a stale socket file from a previous run would make bind fail
+    unlink(socketPath_.c_str());
+
+    if (bind(listenFd_, (struct sockaddr *)&addr, sizeof(addr)) == -1 ||
+        listen(listenFd_, SOMAXCONN) == -1)
+    {
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd_;
+    if (epollFd_ == -1 || epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &ev) == -1)
+    {
+        return false;
+    }
+    return true;
+}
+
+int SocketServerTelemetrySourceImpl::getFd() const
+{
+    return epollFd_;
+}
+
+bool SocketServerTelemetrySourceImpl::setNonBlocking()
+{
+    // listener and connections are created non-blocking
+    return epollFd_ != -1;
+}
+
+void SocketServerTelemetrySourceImpl::acceptAll()
+{
+    while (true)
+    {
+        int fd = accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1)
+        {
+            return; // EAGAIN or a transient error; epoll will report the next one
+        }
+        if (connections_.size() >= maxConnections_)
+        {
+            close(fd);
+            continue;
+        }
+
+        Connection conn{ConnectionStats{}, RecordFramer(framing_, 16 * 1024)};
+        conn.stats.fd = fd;
+        struct ucred cred;
+        socklen_t len = sizeof(cred);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0)
+        {
+            conn.stats.pid = cred.pid;
+        }
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) == -1)
+        {
+            close(fd);
+            continue;
+        }
+        std::cout << "[CLIENT] Agent connected (pid " << conn.stats.pid << ", "
+                  << connections_.size() + 1 << " open)\n";
+        connections_.emplace(fd, std::move(conn));
+        ++accepted_;
+    }
+}
+
+void SocketServerTelemetrySourceImpl::printStats(const ConnectionStats &stats, const char *state)
+{
+    std::cout << "[CLIENT] Agent " << state << " (pid " << stats.pid << "): "
+              << stats.records << " records, " << stats.bytes << " bytes, "
+              << stats.framingErrors << " framing errors\n";
+}
+
+void SocketServerTelemetrySourceImpl::printSummary() const
+{
+    std::cout << "[CLIENT] " << socketPath_ << ": " << accepted_ << " agents accepted, "
+              << closed_ << " disconnected\n";
+    for (const auto &stats : getConnectionStats())
+    {
+        printStats(stats, "still connected");
+    }
+}
+
+void SocketServerTelemetrySourceImpl::closeConnection(int fd)
+{
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    auto it = connections_.find(fd);
+    if (it != connections_.end())
+    {
+        printStats(it->second.stats, "disconnected");
+        retired_.push_back(std::move(it->second));
+        connections_.erase(it);
+    }
+    ++closed_;
+}
+
+bool SocketServerTelemetrySourceImpl::readConnection(Connection &conn, std::vector<std::string_view> &out)
+{
+    // fill the connection's framing buffer as far as the socket allows, then split once
+    conn.framer.reclaim();
+    bool alive = true;
+    while (conn.framer.tailSpace() > 0)
+    {
+        ssize_t n = read(conn.stats.fd, conn.framer.tail(), conn.framer.tailSpace());
+        if (n > 0)
+        {
+            conn.framer.commit(static_cast<size_t>(n));
+            conn.stats.bytes += static_cast<uint64_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        alive = (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+        break;
+    }
+
+    const size_t before = out.size();
+    if (!conn.framer.split(out))
+    {
+        alive = false;
+    }
+    if (!alive)
+    {
+        // peer closed after an unterminated last line
+        conn.framer.takePartial(out);
+    }
+    conn.stats.records += out.size() - before;
+    conn.stats.framingErrors = conn.framer.getFramingErrors();
+    return alive;
+}
+
+ReadStatus SocketServerTelemetrySourceImpl::ReadAvailable(std::vector<std::string_view> &out)
+{
+    if (listenFd_ == -1)
+    {
+        return ReadStatus::CLOSED;
+    }
+
+    // views from the previous cycle have expired
+    retired_.clear();
+    const size_t before = out.size();
+
+    constexpr int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    int n = epoll_wait(epollFd_, events, MAX_EVENTS, 0);
+
+    for (int i = 0; i < n; ++i)
+    {
+        int fd = events[i].data.fd;
+        if (fd == listenFd_)
+        {
+            acceptAll();
+            continue;
+        }
+        auto it = connections_.find(fd);
+        if (it == connections_.end())
+        {
+            continue;
+        }
+        if (!readConnection(it->second, out))
+        {
+            closeConnection(fd);
+        }
+    }
+
+    return out.size() > before ? ReadStatus::OK : ReadStatus::WOULD_BLOCK;
+}
+
+bool SocketServerTelemetrySourceImpl::ReadSource(std::string &out)
+{
+    // blocking convenience wrapper for callers outside the reactor
+    while (pending_.empty())
+    {
+        epoll_event ev;
+        if (epoll_wait(epollFd_, &ev, 1, -1) < 0 && errno != EINTR)
+        {
+            return false;
+        }
+        std::vector<std::string_view> batch;
+        if (ReadAvailable(batch) == ReadStatus::CLOSED)
+        {
+            return false;
+        }
+        for (auto record : batch)
+        {
+            pending_.emplace_back(record);
+        }
+    }
+    out = std::move(pending_.front());
+    pending_.pop_front();
+    return true;
+}
+
+std::vector<ConnectionStats> SocketServerTelemetrySourceImpl::getConnectionStats() const
+{
+    std::vector<ConnectionStats> stats;
+    stats.reserve(connections_.size());
+    for (const auto &[fd, conn] : connections_)
+    {
+        stats.push_back(conn.stats);
+    }
+    return stats;
+}
+
+uint64_t SocketServerTelemetrySourceImpl::getAcceptedCount() const
+{
+    return accepted_;
+}
+
+uint64_t SocketServerTelemetrySourceImpl::getClosedCount() const
+{
+    return closed_;
+}
@@ -1,4 +1,5 @@
 #include "SocketTelemetrySourceImpl.hpp"
+#include <cerrno>
 
 SocketTelemetrySourceImpl::SocketTelemetrySourceImpl(const std::string &socketPath)
     : socketPath_(socketPath), socket_(nullptr)
@@ -8,6 +9,7 @@ SocketTelemetrySourceImpl::SocketTelemetrySourceImpl(const std::string &socketPa
 bool SocketTelemetrySourceImpl::OpenSource()
 {
     socket_ = std::make_unique<SafeSocket>(socketPath_);
+    closed_ = false;
     if(socket_->Connect())
     {
         return socket_->isOpen();
@@ -17,16 +19,71 @@ bool SocketTelemetrySourceImpl::OpenSource()
 
 bool SocketTelemetrySourceImpl::ReadSource(std::string &out)
 {
-    if (socket_ && socket_->isOpen())
+    while (next_ == batch_.size())
     {
-        char buffer[4096];
-        ssize_t bytes = socket_->Read(buffer, sizeof(buffer));
-        if (bytes <= 0)
+        batch_.clear();
+        next_ = 0;
+        if (ReadAvailable(batch_) == ReadStatus::CLOSED && batch_.empty())
         {
             return false;
         }
-        out.assign(buffer, bytes);
-        return true;
     }
-    return false;
+    out.assign(batch_[next_++]);
+    return true;
+}
+
+int SocketTelemetrySourceImpl::getFd() const
+{
+    return socket_ ? socket_->getFd() : -1;
+}
+
+bool SocketTelemetrySourceImpl::setNonBlocking()
+{
+    nonBlocking_ = socket_ && socket_->setNonBlocking();
+    return nonBlocking_;
+}
+
+ReadStatus SocketTelemetrySourceImpl::ReadAvailable(std::vector<std::string_view> &out)
+{
+    if (!socket_ || !socket_->isOpen() || closed_)
+    {
+        return ReadStatus::CLOSED;
+    }
+
+    // fill the framing buffer as far as the socket allows, then split once
+    framer_.reclaim();
+    ReadStatus status = ReadStatus::OK;
+    while (framer_.tailSpace() > 0)
+    {
+        ssize_t bytes = socket_->Read(framer_.tail(), framer_.tailSpace());
+        if (bytes > 0)
+        {
+            framer_.commit(static_cast<size_t>(bytes));
+            if (!nonBlocking_)
+            {
+                break; // blocking socket (ReadSource outside the reactor): one read per call
+            }
+            continue;
+        }
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            status = ReadStatus::WOULD_BLOCK;
+            break;
+        }
+        closed_ = true;
+        status = ReadStatus::CLOSED;
+        break;
+    }
+
+    framer_.split(out);
+    if (status == ReadStatus::CLOSED)
+    {
+        framer_.takePartial(out);
+        return status;
+    }
+    return out.empty() ? status : ReadStatus::OK;
 }
\ No newline at end of file
@@ -0,0 +1,440 @@
+#include "UdpTelemetrySourceImpl.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#ifndef SO_RXQ_OVFL
+#define SO_RXQ_OVFL 40
+#endif
+
+UdpTelemetrySourceImpl::UdpTelemetrySourceImpl(const std::string &address, size_t shards, size_t slotSize)
+    : address_(address), shards_(shards > 0 ? shards : 1), slotSize_(slotSize > 0 ? slotSize : 2048)
+{
+}
+
+UdpTelemetrySourceImpl::~UdpTelemetrySourceImpl()
+{
+    stop();
+    for (auto &rx : receivers_)
+    {
+        if (rx->fd != -1)
+        {
+            close(rx->fd);
+        }
+    }
+    if (wakeFd_ != -1)
+    {
+        close(wakeFd_);
+    }
+}
+
+// "host:port", "host", "[v6]:port" or "[v6]"; the port defaults to 5140
+static bool splitHostPort(const std::string &address, std::string &host, std::string &port)
+{
+    port = "5140";
+    std::string rest;
+    if (!address.empty() && address.front() == '[')
+    {
+        auto close = address.find(']');
+        if (close == std::string::npos)
+        {
+            return false;
+        }
+        host = address.substr(1, close - 1);
+        rest = address.substr(close + 1);
+    }
+    else
+    {
+        auto colon = address.find(':');
+        if (colon != address.rfind(':'))
+        {
+            return false; // a bare IPv6 address is ambiguous with a port
+        }
+        host = address.substr(0, colon);
+        rest = (colon == std::string::npos) ? std::string() : address.substr(colon);
+    }
+
+    if (rest.empty())
+    {
+        return true;
+    }
+    if (rest.front() != ':' || rest.size() == 1)
+    {
+        return false;
+    }
+    port = rest.substr(1);
+    return true;
+}
+
+bool UdpTelemetrySourceImpl::openReceiver(Receiver &rx, bool reusePort, bool blocking)
+{
+    std::string host;
+    std::string port;
+    if (!splitHostPort(address_, host, port))
+    {
+        std::cerr << "[UDP] Invalid address \"" << address_ << "\", expected host:port or [ipv6]:port\n";
+        return false;
+    }
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_PASSIVE;
+    struct addrinfo *res = nullptr;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &res) != 0)
+    {
+        return false;
+    }
+
+    int type = SOCK_DGRAM | SOCK_CLOEXEC | (blocking ? 0 : SOCK_NONBLOCK);
+    rx.fd = socket(res->ai_family, type, 0);
+    int on = 1;
+    bool ok = rx.fd != -1 &&
+              setsockopt(rx.fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on)) == 0 &&
+              (!reusePort || setsockopt(rx.fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) == 0) &&
+              bind(rx.fd, res->ai_addr, res->ai_addrlen) == 0;
+    freeaddrinfo(res);
+    if (!ok)
+    {
+        if (rx.fd != -1)
+        {
+            close(rx.fd);
+            rx.fd = -1;
+        }
+        return false;
+    }
+
+    // receive buffers are wired into the headers once and reused for every batch
+    const size_t controlSize = CMSG_SPACE(sizeof(uint32_t));
+    rx.slots.assign(BATCH * slotSize_, 0);
+    rx.control.assign(BATCH * controlSize, 0);
+    rx.iov.resize(BATCH);
+    rx.msgs.assign(BATCH, mmsghdr{});
+    for (size_t i = 0; i < BATCH; ++i)
+    {
+        rx.iov[i].iov_base = rx.slots.data() + i * slotSize_;
+        rx.iov[i].iov_len = slotSize_;
+        rx.msgs[i].msg_hdr.msg_iov = &rx.iov[i];
+        rx.msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    return true;
+}
+
+int UdpTelemetrySourceImpl::receiveBatch(Receiver &rx, int flags)
+{
+    const size_t controlSize = CMSG_SPACE(sizeof(uint32_t));
+    for (size_t i = 0; i < BATCH; ++i)
+    {
+        // the kernel shrinks these on every receive
+        rx.msgs[i].msg_hdr.msg_control = rx.control.data() + i * controlSize;
+        rx.msgs[i].msg_hdr.msg_controllen = controlSize;
+        rx.msgs[i].msg_hdr.msg_flags = 0;
+    }
+
+    int n;
+    do
+    {
+        n = recvmmsg(rx.fd, rx.msgs.data(), BATCH, flags, nullptr);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0)
+    {
+        return n;
+    }
+
+    datagrams_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+    {
+        msghdr &hdr = rx.msgs[i].msg_hdr;
+        if (hdr.msg_flags & MSG_TRUNC)
+        {
+            truncated_.fetch_add(1, std::memory_order_relaxed);
+        }
+        for (cmsghdr *c = CMSG_FIRSTHDR(&hdr); c != nullptr; c = CMSG_NXTHDR(&hdr, c))
+        {
+            if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL)
+            {
+                uint32_t drops;
+                memcpy(&drops, CMSG_DATA(c), sizeof(drops));
+                rx.kernelDrops.store(drops, std::memory_order_relaxed);
+            }
+        }
+    }
+    return n;
+}
+
+template <typename Fn>
+void UdpTelemetrySourceImpl::forEachRecord(Receiver &rx, int count, Fn &&fn)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const char *p = static_cast<const char *>(rx.iov[i].iov_base);
+        const char *end = p + std::min<size_t>(rx.msgs[i].msg_len, slotSize_);
+        while (p < end)
+        {
+            const char *nl = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+            const char *stop = nl ? nl : end;
+            const char *trim = (stop > p && stop[-1] == '\r') ? stop - 1 : stop;
+            if (trim > p)
+            {
+                fn(std::string_view(p, static_cast<size_t>(trim - p)));
+            }
+            p = stop + 1;
+        }
+    }
+}
+
+bool UdpTelemetrySourceImpl::OpenSource()
+{
+    if (!receivers_.empty())
+    {
+        return true;
+    }
+
+    const bool sharded = shards_ > 1;
+    for (size_t i = 0; i < shards_; ++i)
+    {
+        receivers_.push_back(std::make_unique<Receiver>());
+        if (!openReceiver(*receivers_.back(), sharded, sharded))
+        {
+            receivers_.clear();
+            return false;
+        }
+    }
+    if (!sharded)
+    {
+        return true;
+    }
+
+    wakeFd_ = eventfd(0, EFD_CLOEXEC);
+    if (wakeFd_ == -1)
+    {
+        return false;
+    }
+    // both sides of the swap keep their capacity, so steady state never allocates
+    for (auto *bytes : {&inbox_, &outbox_})
+    {
+        bytes->reserve(MAX_INBOX_BYTES + MAX_INBOX_BYTES / 2);
+    }
+    for (auto *records : {&inboxRecords_, &outboxRecords_})
+    {
+        records->reserve(MAX_INBOX_RECORDS);
+    }
+    running_.store(true);
+    for (auto &rx : receivers_)
+    {
+        workers_.emplace_back(&UdpTelemetrySourceImpl::receiverLoop, this, std::ref(*rx));
+    }
+    return true;
+}
+
+void UdpTelemetrySourceImpl::receiverLoop(Receiver &rx)
+{
+    while (running_.load(std::memory_order_relaxed))
+    {
+        // sleeps until at least one datagram, then takes whatever else is queued
+        int n = receiveBatch(rx, MSG_WAITFORONE);
+        if (n <= 0)
+        {
+            if (n < 0 && errno != EAGAIN)
+            {
+                break;
+            }
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex_);
+            forEachRecord(rx, n, [this](std::string_view record)
+            {
+                pushInbox(record);
+            });
+        }
+        uint64_t one = 1;
+        (void)!write(wakeFd_, &one, sizeof(one));
+    }
+}
+
+void UdpTelemetrySourceImpl::pushInbox(std::string_view record)
+{
+    record = record.substr(0, MAX_INBOX_BYTES);
+
+    // a stalled reactor must not grow the inbox without limit: drop the oldest records
+    while (inboxHead_ < inboxRecords_.size() &&
+           (inboxRecords_.size() - inboxHead_ >= MAX_INBOX_RECORDS ||
+            inboxLiveBytes_ + record.size() > MAX_INBOX_BYTES))
+    {
+        inboxLiveBytes_ -= inboxRecords_[inboxHead_].second;
+        ++inboxHead_;
+        inboxDropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // reclaim the dropped prefix once it is large, so memory stays bounded
+    if (inboxHead_ > 0 && inbox_.size() - inboxLiveBytes_ >= MAX_INBOX_BYTES / 2)
+    {
+        const uint32_t base = (inboxHead_ < inboxRecords_.size()) ? inboxRecords_[inboxHead_].first
+                                                                  : static_cast<uint32_t>(inbox_.size());
+        inbox_.erase(0, base);
+        inboxRecords_.erase(inboxRecords_.begin(), inboxRecords_.begin() + static_cast<std::ptrdiff_t>(inboxHead_));
+        for (auto &entry : inboxRecords_)
+        {
+            entry.first -= base;
+        }
+        inboxHead_ = 0;
+    }
+
+    inboxRecords_.emplace_back(static_cast<uint32_t>(inbox_.size()), static_cast<uint32_t>(record.size()));
+    inbox_.append(record);
+    inboxLiveBytes_ += record.size();
+}
+
+void UdpTelemetrySourceImpl::stop()
+{
+    if (!running_.exchange(false))
+    {
+        return;
+    }
+    for (auto &rx : receivers_)
+    {
+        // wakes a receiver blocked in recvmmsg with a zero-length result
+        shutdown(rx->fd, SHUT_RDWR);
+    }
+    for (auto &worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+int UdpTelemetrySourceImpl::getFd() const
+{
+    if (shards_ > 1)
+    {
+        return wakeFd_;
+    }
+    return receivers_.empty() ? -1 : receivers_.front()->fd;
+}
+
+bool UdpTelemetrySourceImpl::setNonBlocking()
+{
+    int fd = getFd();
+    if (fd == -1)
+    {
+        return false;
+    }
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+    {
+        return false;
+    }
+    nonBlocking_ = true;
+    return true;
+}
+
+ReadStatus UdpTelemetrySourceImpl::ReadAvailable(std::vector<std::string_view> &out)
+{
+    if (receivers_.empty())
+    {
+        return ReadStatus::CLOSED;
+    }
+    const size_t before = out.size();
+
+    if (shards_ == 1)
+    {
+        // one batch per call: the next call reuses the slots the views point into
+        int n = receiveBatch(*receivers_.front(), nonBlocking_ ? MSG_DONTWAIT : MSG_WAITFORONE);
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            return ReadStatus::CLOSED;
+        }
+        forEachRecord(*receivers_.front(), n, [&out](std::string_view record)
+        {
+            out.push_back(record);
+        });
+        return out.size() > before ? ReadStatus::OK : ReadStatus::WOULD_BLOCK;
+    }
+
+    uint64_t wakeups;
+    if (read(wakeFd_, &wakeups, sizeof(wakeups)) < 0 && errno != EAGAIN)
+    {
+        return ReadStatus::CLOSED;
+    }
+    outbox_.clear();
+    outboxRecords_.clear();
+    size_t head;
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        std::swap(inbox_, outbox_);
+        std::swap(inboxRecords_, outboxRecords_);
+        head = inboxHead_;
+        inboxHead_ = 0;
+        inboxLiveBytes_ = 0;
+    }
+    for (size_t i = head; i < outboxRecords_.size(); ++i)
+    {
+        out.emplace_back(outbox_.data() + outboxRecords_[i].first, outboxRecords_[i].second);
+    }
+    return out.size() > before ? ReadStatus::OK : ReadStatus::WOULD_BLOCK;
+}
+
+bool UdpTelemetrySourceImpl::ReadSource(std::string &out)
+{
+    // blocking convenience wrapper for callers outside the reactor
+    while (pending_.empty())
+    {
+        struct pollfd pfd{getFd(), POLLIN, 0};
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR)
+        {
+            return false;
+        }
+        std::vector<std::string_view> batch;
+        if (ReadAvailable(batch) == ReadStatus::CLOSED)
+        {
+            return false;
+        }
+        for (auto record : batch)
+        {
+            pending_.emplace_back(record);
+        }
+    }
+    out = std::move(pending_.front());
+    pending_.pop_front();
+    return true;
+}
+
+uint64_t UdpTelemetrySourceImpl::getDatagramCount() const
+{
+    return datagrams_.load(std::memory_order_relaxed);
+}
+
+uint64_t UdpTelemetrySourceImpl::getTruncatedCount() const
+{
+    return truncated_.load(std::memory_order_relaxed);
+}
+
+uint64_t UdpTelemetrySourceImpl::getInboxDroppedCount() const
+{
+    return inboxDropped_.load(std::memory_order_relaxed);
+}
+
+void UdpTelemetrySourceImpl::printSummary() const
+{
+    std::cout << "[CLIENT] " << address_ << ": " << getDatagramCount() << " datagrams, "
+              << getDroppedCount() << " dropped by the kernel, " << getInboxDroppedCount()
+              << " records dropped from the inbox, " << getTruncatedCount() << " truncated\n";
+}
+
+uint64_t UdpTelemetrySourceImpl::getDroppedCount() const
+{
+    uint64_t total = 0;
+    for (const auto &rx : receivers_)
+    {
+        total += rx->kernelDrops.load(std::memory_order_relaxed);
+    }
+    return total;
+}
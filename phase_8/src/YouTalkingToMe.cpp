@@ -1,7 +1,10 @@
 #include "YouTalkingToMe.hpp"
 #include "config.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <charconv>
 #include <sstream>
 #include <chrono>
 #include <thread>
@@ -13,8 +16,7 @@ YouTalkingToMe::YouTalkingToMe(const std::string& configPath)
       cpuFileSink("cpu.log"),                       
       ramFileSink("ram.log"),
       tempFileSink("temp.log"),
-      logger(100),                                  
-      source(CommonAPITelemetrySourceImpl::getInstance())
+      logger(100)
 {
     std::cout << "\n========================================\n"
               << "Telemetry logging app created (config: " << configPath << ")\n"
@@ -27,34 +29,79 @@ void YouTalkingToMe::setupLogger()
 {
     logmanagerbuilder builder(100);
 
+    // lossless while the sink keeps up, unless it opts into dropping
+    auto overflowFor = [&](const std::string& sinkKey) {
+        auto it = config.asyncSinkOverflow.find(sinkKey);
+        const std::string& name = (it != config.asyncSinkOverflow.end()) ? it->second : config.asyncOverflow;
+        return magic_enum::enum_cast<OverflowPolicy>(name, magic_enum::case_insensitive)
+            .value_or(OverflowPolicy::BLOCK);
+    };
+
+    LogFilterOptions filterOptions;
+    filterOptions.dedup = config.filterDedup;
+    filterOptions.ratePerSec[*magic_enum::enum_index(SeverityLvl_enum::INFO)]     = config.infoPerSec;
+    filterOptions.ratePerSec[*magic_enum::enum_index(SeverityLvl_enum::WARNING)]  = config.warningPerSec;
+    filterOptions.ratePerSec[*magic_enum::enum_index(SeverityLvl_enum::CRITICAL)] = config.criticalPerSec;
+    filterOptions.burst = config.rateBurst;
+    filterOptions.infoSampleRate = config.infoSampleRate;
+    builder.setFilter(filterOptions);
+
+    auto addSink = [&](const std::string& sinkKey, Ilogsink* sink, const SinkRoute& route) {
+        if (config.asyncSinks) {
+            AsyncSinkOptions asyncOptions;
+            asyncOptions.queueCapacity = config.asyncQueueSize;
+            asyncOptions.overflow = overflowFor(sinkKey);
+            asyncOptions.blockTimeout = std::chrono::milliseconds(std::max(1, config.asyncBlockMs));
+            builder.addAsyncSink(sink, asyncOptions, route);
+        } else {
+            builder.addSink(sink, route);
+        }
+    };
+
     if (config.sinkConsole) {
-        builder.addSink(&consoleSink);
+        addSink("console", &consoleSink, SinkRoute{});
     }
     if (config.sinkCpuFile) {
-        builder.addSink(&cpuFileSink);
+        addSink("cpu_file", &cpuFileSink, SinkRoute{TelemetrySrc_enum::CPU});
     }
     if (config.sinkRamFile) {
-        builder.addSink(&ramFileSink);
+        addSink("ram_file", &ramFileSink, SinkRoute{TelemetrySrc_enum::RAM});
     }
     if (config.sinkTempFile) {
-        builder.addSink(&tempFileSink);
+        addSink("temp_file", &tempFileSink, SinkRoute{TelemetrySrc_enum::TEMP});
+    }
+    if (config.sinkBinaryFile) {
+        binaryFileSink = std::make_unique<binarysink>("telemetry.tlm");
+        addSink("binary_file", binaryFileSink.get(), SinkRoute{});
+    }
+    if (!config.sinkShm.empty()) {
+        shmSink = std::make_unique<shmsink>(config.sinkShm);
+        addSink("shm", shmSink.get(), SinkRoute{});
     }
 
     logger = builder.build();
 }
 
 void YouTalkingToMe::pushMeasurement(const std::string& policyName,
-                                          const std::string& valueStr)
+                                          const std::string& valueStr, int64_t timeMs)
 {
     
     std::optional<logmessage> msg;
 
     if (policyName == "cpu") {
-        msg = LogFormatter<CpuPolicy>::formatDataToLogMsg(valueStr);
+        msg = LogFormatter<CpuPolicy>::formatDataToLogMsg(valueStr, timeMs);
     } else if (policyName == "ram") {
-        msg = LogFormatter<RamPolicy>::formatDataToLogMsg(valueStr);
+        msg = LogFormatter<RamPolicy>::formatDataToLogMsg(valueStr, timeMs);
     } else if (policyName == "temp") {
-        msg = LogFormatter<TempPolicy>::formatDataToLogMsg(valueStr);
+        msg = LogFormatter<TempPolicy>::formatDataToLogMsg(valueStr, timeMs);
+    } else if (policyName == "disk") {
+        msg = LogFormatter<DiskPolicy>::formatDataToLogMsg(valueStr, timeMs);
+    } else if (policyName == "net") {
+        msg = LogFormatter<NetPolicy>::formatDataToLogMsg(valueStr, timeMs);
+    } else if (policyName == "pressure") {
+        msg = LogFormatter<PressurePolicy>::formatDataToLogMsg(valueStr, timeMs);
+    } else if (policyName == "proc") {
+        msg = LogFormatter<ProcPolicy>::formatDataToLogMsg(valueStr, timeMs);
     } else {
         
         return;
@@ -69,6 +116,97 @@ void YouTalkingToMe::pushMeasurement(const std::string& policyName,
     }
 }
 
+void YouTalkingToMe::pushMetric(const SourceConfig& sc, std::string_view source, const std::string& label, float value,
+                                int64_t timeMs)
+{
+    auto ctx = magic_enum::enum_cast<TelemetrySrc_enum>(source, magic_enum::case_insensitive);
+    if (!ctx) {
+        return;
+    }
+
+    // an unlabelled value is the aggregate (CPU/RAM/TEMP of the shm source), logged like a cpu;temp;ram field
+    if (label.empty()) {
+        std::string policyName(magic_enum::enum_name(*ctx));
+        std::transform(policyName.begin(), policyName.end(), policyName.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        pushMeasurement(policyName, std::to_string(value), timeMs);
+        return;
+    }
+
+    std::optional<logmessage> msg;
+    switch (*ctx) {
+    case TelemetrySrc_enum::CPU: {
+        // per-core total from the shared-memory ring; the label is the core number
+        size_t core = 0;
+        if (std::from_chars(label.data(), label.data() + label.size(), core).ec != std::errc() ||
+            !shouldLogCore(sc, core, static_cast<int>(value))) {
+            return;
+        }
+        msg = LogFormatter<CpuPolicy>::formatCoreToLogMsg(core, value, timeMs);
+        break;
+    }
+    case TelemetrySrc_enum::TEMP:
+        msg = LogFormatter<TempPolicy>::formatMetricToLogMsg(label, value, timeMs);
+        break;
+    case TelemetrySrc_enum::DISK:
+        msg = LogFormatter<DiskPolicy>::formatMetricToLogMsg(label, value, timeMs);
+        break;
+    case TelemetrySrc_enum::NET:
+        msg = LogFormatter<NetPolicy>::formatMetricToLogMsg(label, value, timeMs);
+        break;
+    case TelemetrySrc_enum::PRESSURE:
+        msg = LogFormatter<PressurePolicy>::formatMetricToLogMsg(label, value, timeMs);
+        break;
+    case TelemetrySrc_enum::PROC:
+        msg = LogFormatter<ProcPolicy>::formatMetricToLogMsg(label, value, timeMs);
+        break;
+    default:
+        return; // RAM has no labelled values
+    }
+
+    if (!msg) {
+        return;
+    }
+
+    while (!formattedQueue.tryPush(std::move(*msg))) {
+        std::this_thread::yield();
+    }
+}
+
+bool YouTalkingToMe::shouldLogCore(const SourceConfig& sc, size_t core, int total)
+{
+    if (sc.perCore == "off") {
+        return false;
+    }
+
+    if (core >= coreAlerting.size()) {
+        coreAlerting.resize(core + 1, false);
+    }
+    bool alerting = total > CpuPolicy::WARNING;
+    bool changed = alerting != coreAlerting[core];
+    coreAlerting[core] = alerting;
+
+    // "alerts" logs a hot core on every sample and once more when it drops back below WARNING
+    return sc.perCore == "all" || alerting || changed;
+}
+
+void YouTalkingToMe::pushCoreMeasurement(const SourceConfig& sc, size_t core, const int (&values)[5], int64_t timeMs)
+{
+    if (!shouldLogCore(sc, core, values[0])) {
+        return;
+    }
+
+    auto msg = LogFormatter<CpuPolicy>::formatCoreToLogMsg(core, values[0], values[1], values[2],
+                                                           values[3], values[4], timeMs);
+    if (!msg) {
+        return;
+    }
+
+    while (!formattedQueue.tryPush(std::move(*msg))) {
+        std::this_thread::yield();
+    }
+}
+
 void YouTalkingToMe::runConsumer()
 {
     std::cout << "[LOGGER] Consumer thread started\n";
@@ -92,6 +230,7 @@ void YouTalkingToMe::runConsumer()
                 while (auto last = formattedQueue.tryPop()) {
                     logger.log(*last);
                 }
+                logger.flushSuppressed();
                 logger.flush();
                 break;
             }
@@ -100,78 +239,205 @@ void YouTalkingToMe::runConsumer()
     }
 
     std::cout << "[LOGGER] Consumer finished — " << msgCount << " messages logged\n";
+    if (logger.getSuppressedCount() != 0) {
+        std::cout << "[LOGGER] Filter suppressed " << logger.getSuppressedCount() << " messages\n";
+    }
+    const auto dropped = logger.getDroppedCounts();
+    for (size_t i = 0; i < dropped.size(); ++i) {
+        if (dropped[i] != 0) {
+            std::cout << "[LOGGER] Sink " << i << " dropped " << dropped[i] << " messages\n";
+        }
+    }
     consumerDone.store(true, std::memory_order_release);
 }
 
-void YouTalkingToMe::runProducer()
+ITelemetrySource* YouTalkingToMe::makeSource(const SourceConfig& sc)
 {
-    std::cout << "[FORMATTER] Producer thread started\n";
-
-    int iteration = 0;
-    std::string raw;
-
+    if (sc.type == "someip") {
+        auto& someip = CommonAPITelemetrySourceImpl::getInstance();
+        someip.setMode(magic_enum::enum_cast<CommonAPITelemetrySourceImpl::Mode>(sc.mode, magic_enum::case_insensitive)
+                           .value_or(CommonAPITelemetrySourceImpl::Mode::EVENT));
+        someip.setRequestOptions(static_cast<size_t>(sc.outstanding), sc.timeoutMs, sc.requestMs);
+        return &someip;
+    }
+    if (sc.type == "file") {
+        ownedSources.push_back(std::make_unique<FileTelemetrySourceImpl>(sc.path, sc.follow, sc.offsetFile));
+        return ownedSources.back().get();
+    }
+    if (sc.type == "socket") {
+        ownedSources.push_back(std::make_unique<SocketTelemetrySourceImpl>(sc.path));
+        return ownedSources.back().get();
+    }
+    if (sc.type == "mmap") {
+        ownedSources.push_back(std::make_unique<MmapTelemetrySourceImpl>(sc.path, sc.replayRate));
+        return ownedSources.back().get();
+    }
+    if (sc.type == "udp") {
+        ownedSources.push_back(std::make_unique<UdpTelemetrySourceImpl>(sc.address, static_cast<size_t>(sc.shards)));
+        return ownedSources.back().get();
+    }
+    if (sc.type == "shm") {
+        ownedSources.push_back(std::make_unique<ShmTelemetrySourceImpl>(sc.path));
+        return ownedSources.back().get();
+    }
+    if (sc.type == "socket_server") {
+        FramingMode framing = magic_enum::enum_cast<FramingMode>(sc.framing, magic_enum::case_insensitive)
+                                  .value_or(FramingMode::NEWLINE);
+        ownedSources.push_back(std::make_unique<SocketServerTelemetrySourceImpl>(sc.path, framing));
+        return ownedSources.back().get();
+    }
+    return nullptr;
+}
 
-    std::cout << "[CLIENT] Initializing telemetry source (" << config.sourceType << ")...\n";
-    if (!source.OpenSource()) {
-        std::cerr << "[CLIENT] Failed to open telemetry source\n"
-                  << "[CLIENT] Make sure server is running!\n";
-        done.store(true, std::memory_order_release);
-        return;
+void YouTalkingToMe::handleRecord(const SourceConfig& sc, std::string_view raw)
+{
+    // parses an integer after optional blanks and advances p past it
+    auto parseInt = [end = raw.data() + raw.size()](const char*& p, int& value) {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        auto [next, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc()) {
+            return false;
+        }
+        p = next;
+        return true;
+    };
+    auto expect = [end = raw.data() + raw.size()](const char*& p, char c) {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        if (p == end || *p != c) {
+            return false;
+        }
+        ++p;
+        return true;
+    };
+
+    // typed samples (SOME/IP batches, shm records) lead with "@<epoch ms> ", their sampling time
+    int64_t timeMs = 0;
+    if (!raw.empty() && raw.front() == '@') {
+        auto [next, ec] = std::from_chars(raw.data() + 1, raw.data() + raw.size(), timeMs);
+        if (ec != std::errc() || next == raw.data() + raw.size() || *next != ' ') {
+            std::cout << "[FORMATTER] Parse error (timestamp): " << raw << "\n";
+            return;
+        }
+        raw.remove_prefix(static_cast<size_t>(next + 1 - raw.data()));
     }
-    std::cout << "[CLIENT] Telemetry source opened successfully\n\n";
-
-    while (source.ReadSource(raw)) {
-        ++iteration;
-        std::cout << "[FORMATTER] Iteration " << iteration
-                  << ": " << raw << "\n";
-
-        if (config.sourceType == "someip") {
-            int v0 = 0, v1 = 0, v2 = 0;
-            char s1 = 0, s2 = 0;
-            {
-                std::stringstream ss(raw);
-                if (!(ss >> v0 >> s1 >> v1 >> s2 >> v2) ||
-                    s1 != ';' || s2 != ';') {
-                    std::cout << "[FORMATTER] Parse error: " << raw << "\n";
-                    continue;
-                }
-            }
 
-            int values[3] = {v0, v1, v2};
+    const char* p = raw.data();
+
+    if ((sc.type == "someip" || sc.type == "shm") && p != raw.data() + raw.size() &&
+        ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) {
+        // collector metric "<SOURCE> <label> <value>"; the label may itself contain blanks,
+        // and is missing for the aggregate CPU/RAM/TEMP values of the shm source
+        size_t sourceEnd = raw.find(' ');
+        size_t valueStart = raw.rfind(' ');
+        float value = 0.0f;
+        if (sourceEnd == std::string_view::npos ||
+            std::from_chars(raw.data() + valueStart + 1, raw.data() + raw.size(), value).ec != std::errc()) {
+            std::cout << "[FORMATTER] Parse error (metric): " << raw << "\n";
+            return;
+        }
+        std::string label;
+        if (valueStart > sourceEnd) {
+            label.assign(raw.substr(sourceEnd + 1, valueStart - sourceEnd - 1));
+        }
+        pushMetric(sc, raw.substr(0, sourceEnd), label, value, timeMs);
+    } else if (sc.type == "someip") {
+        int v0 = 0, v1 = 0, v2 = 0;
+        if (!parseInt(p, v0) || !expect(p, ';') ||
+            !parseInt(p, v1) || !expect(p, ';') ||
+            !parseInt(p, v2)) {
+            std::cout << "[FORMATTER] Parse error: " << raw << "\n";
+            return;
+        }
 
-            
-            if (config.mapping.size() == 3) {
-                for (int i = 0; i < 3; ++i) {
-                    pushMeasurement(config.mapping[i],
-                                    std::to_string(values[i]));
-                }
-            } else {
-               
-                pushMeasurement("cpu",  std::to_string(v0));
-                pushMeasurement("temp", std::to_string(v1));
-                pushMeasurement("ram",  std::to_string(v2));
+        int values[3] = {v0, v1, v2};
+
+        
+        if (sc.mapping.size() == 3) {
+            for (int i = 0; i < 3; ++i) {
+                pushMeasurement(sc.mapping[i],
+                                std::to_string(values[i]), timeMs);
             }
         } else {
            
-            int value = 0;
-            {
-                std::stringstream ss(raw);
-                if (!(ss >> value)) {
-                    std::cout << "[FORMATTER] Parse error (single value): " << raw << "\n";
-                    continue;
+            pushMeasurement("cpu",  std::to_string(v0), timeMs);
+            pushMeasurement("temp", std::to_string(v1), timeMs);
+            pushMeasurement("ram",  std::to_string(v2), timeMs);
+        }
+
+        // batch records append one "total/user/system/iowait/steal" group per core
+        for (size_t core = 0; expect(p, ';'); ++core) {
+            int loads[5] = {};
+            for (int i = 0; i < 5; ++i) {
+                if ((i > 0 && !expect(p, '/')) || !parseInt(p, loads[i])) {
+                    std::cout << "[FORMATTER] Parse error (core " << core << "): " << raw << "\n";
+                    return;
                 }
             }
-            pushMeasurement(config.policy, std::to_string(value));
+            pushCoreMeasurement(sc, core, loads, timeMs);
         }
+    } else {
+       
+        int value = 0;
+        if (!parseInt(p, value)) {
+            std::cout << "[FORMATTER] Parse error (single value): " << raw << "\n";
+            return;
+        }
+        pushMeasurement(sc.policy, std::to_string(value), timeMs);
+    }
+}
+
+void YouTalkingToMe::runProducer()
+{
+    std::cout << "[FORMATTER] Producer thread started\n";
+
+    size_t records = 0;
+
+    // parse_ms paces the sources that cannot be polled while they are idle
+    IngestionReactor reactor(config.parseMs);
+
+    for (const auto& sc : config.sources) {
+        std::cout << "[CLIENT] Initializing telemetry source (" << sc.type << ")...\n";
+
+        ITelemetrySource* src = makeSource(sc);
+        if (!src) {
+            std::cerr << "[CLIENT] Unknown source type: " << sc.type << "\n";
+            continue;
+        }
+        bool added = reactor.addSource(*src, [this, &sc, &records](std::string_view raw) {
+            ++records;
+            handleRecord(sc, raw);
+        });
+        if (!added) {
+            std::cerr << "[CLIENT] Failed to open telemetry source (" << sc.type << ")\n";
+            continue;
+        }
+    }
+
+    if (reactor.getActiveCount() == 0) {
+        std::cerr << "[CLIENT] No telemetry source could be opened\n"
+                  << "[CLIENT] Make sure server is running!\n";
+        done.store(true, std::memory_order_release);
+        return;
+    }
+    std::cout << "[CLIENT] " << reactor.getActiveCount() << " telemetry source(s) opened successfully\n\n";
+
+    reactor.run();
 
-        if (config.parseMs > 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(config.parseMs));
+    for (const auto& src : ownedSources) {
+        if (auto* server = dynamic_cast<const SocketServerTelemetrySourceImpl*>(src.get())) {
+            server->printSummary();
+        } else if (auto* udp = dynamic_cast<const UdpTelemetrySourceImpl*>(src.get())) {
+            udp->printSummary();
         }
     }
 
     done.store(true, std::memory_order_release);
     std::cout << "[FORMATTER] Producer finished after "
-              << iteration << " iterations\n";
+              << records << " records\n";
 }
 
 void YouTalkingToMe::start()
@@ -0,0 +1,118 @@
+#include "asyncsink.hpp"
+#include <iostream>
+#include <vector>
+
+asyncsink::asyncsink(Ilogsink *target, const AsyncSinkOptions &options)
+    : target(target),
+      overflow(options.overflow),
+      blockTimeout(options.blockTimeout),
+      queue(options.queueCapacity > 0 ? options.queueCapacity : 1)
+{
+    worker = std::thread([this]()
+                         { this->loop(); });
+}
+
+asyncsink::~asyncsink()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void asyncsink::write(const logmessage &msg)
+{
+    std::unique_lock<std::mutex> lock(mtx);
+
+    if (queue.isFull())
+    {
+        switch (overflow)
+        {
+        case OverflowPolicy::BLOCK:
+            // a stuck sink must not stall the consumer: wait a bounded time, then shed
+            // new messages without waiting until the worker takes a batch again
+            if (!stalled && notFull.wait_for(lock, blockTimeout, [this]()
+                                             { return !queue.isFull() || stopping; }) &&
+                !stopping)
+            {
+                break;
+            }
+            if (!stalled && !stopping)
+            {
+                std::cerr << "[asyncsink] sink stalled for " << blockTimeout.count()
+                          << " ms, dropping until it catches up\n";
+            }
+            stalled = true;
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        case OverflowPolicy::DROP_NEW:
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        case OverflowPolicy::DROP_OLDEST:
+            break;
+        }
+    }
+
+    // RingBuffer overwrites the oldest entry when full and reports it
+    if (!queue.tryPush(msg))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    lock.unlock();
+    notEmpty.notify_one();
+}
+
+void asyncsink::flush()
+{
+    // the worker flushes the wrapped sink after every batch it drains
+    notEmpty.notify_one();
+}
+
+void asyncsink::loop()
+{
+    std::vector<logmessage> batch;
+    batch.reserve(queue.getCapacity());
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            notEmpty.wait(lock, [this]()
+                          { return !queue.isEmpty() || stopping; });
+            if (queue.isEmpty() && stopping)
+            {
+                break;
+            }
+            while (auto msg = queue.tryPop())
+            {
+                batch.push_back(std::move(*msg));
+            }
+            stalled = false;
+        }
+        notFull.notify_all();
+
+        for (const auto &msg : batch)
+        {
+            target->write(msg);
+        }
+        target->flush();
+        delivered.fetch_add(batch.size(), std::memory_order_relaxed);
+        batch.clear();
+    }
+}
+
+uint64_t asyncsink::getDroppedCount() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t asyncsink::getDeliveredCount() const
+{
+    return delivered.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,299 @@
+#include "binaryreader.hpp"
+#include "binaryformat.hpp"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace binaryformat;
+
+namespace
+{
+    bool preadAll(int fd, char *buffer, size_t size, uint64_t offset)
+    {
+        while (size > 0)
+        {
+            ssize_t n = pread(fd, buffer, size, static_cast<off_t>(offset));
+            if (n <= 0)
+            {
+                return false;
+            }
+            buffer += n;
+            size -= static_cast<size_t>(n);
+            offset += static_cast<uint64_t>(n);
+        }
+        return true;
+    }
+}
+
+BinaryTelemetryReader::BinaryTelemetryReader(const std::string &path)
+{
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd != -1 && !loadIndex())
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+
+BinaryTelemetryReader::~BinaryTelemetryReader()
+{
+    if (fd != -1)
+    {
+        close(fd);
+    }
+}
+
+bool BinaryTelemetryReader::loadIndex()
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE)
+    {
+        return false;
+    }
+    const uint64_t fileSize = static_cast<uint64_t>(st.st_size);
+
+    char header[HEADER_SIZE];
+    if (!preadAll(fd, header, sizeof(header), 0) ||
+        std::memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        get<uint16_t>(header + 4) != VERSION)
+    {
+        return false;
+    }
+
+    // no valid footer: the writer did not get to close the file
+    if (!loadFooter(fileSize))
+    {
+        index.clear();
+        scanBlockHeaders(fileSize);
+    }
+    return true;
+}
+
+bool BinaryTelemetryReader::loadFooter(uint64_t fileSize)
+{
+    char tail[TAIL_SIZE];
+    if (fileSize < HEADER_SIZE + TAIL_SIZE ||
+        !preadAll(fd, tail, sizeof(tail), fileSize - TAIL_SIZE) ||
+        std::memcmp(tail + 12, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    const uint64_t indexOffset = get<uint64_t>(tail);
+    const uint32_t blockCount = get<uint32_t>(tail + 8);
+    if (indexOffset + static_cast<uint64_t>(blockCount) * INDEX_ENTRY_SIZE + TAIL_SIZE != fileSize)
+    {
+        return false;
+    }
+
+    std::string raw(static_cast<size_t>(blockCount) * INDEX_ENTRY_SIZE, '\0');
+    if (!preadAll(fd, raw.data(), raw.size(), indexOffset))
+    {
+        return false;
+    }
+
+    index.resize(blockCount);
+    for (uint32_t i = 0; i < blockCount; ++i)
+    {
+        const char *p = raw.data() + i * INDEX_ENTRY_SIZE;
+        index[i].offset = get<uint64_t>(p);
+        index[i].rows = get<uint32_t>(p + 8);
+        index[i].minTs = get<int64_t>(p + 12);
+        index[i].maxTs = get<int64_t>(p + 20);
+    }
+    for (uint32_t i = 0; i < blockCount; ++i)
+    {
+        uint64_t next = (i + 1 < blockCount) ? index[i + 1].offset : indexOffset;
+        if (next < index[i].offset + BLOCK_HEADER_SIZE)
+        {
+            return false;
+        }
+        index[i].size = next - index[i].offset;
+    }
+    return true;
+}
+
+void BinaryTelemetryReader::scanBlockHeaders(uint64_t fileSize)
+{
+    uint64_t offset = HEADER_SIZE;
+    char header[BLOCK_HEADER_SIZE];
+    while (offset + BLOCK_HEADER_SIZE <= fileSize &&
+           preadAll(fd, header, sizeof(header), offset) &&
+           std::memcmp(header, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) == 0)
+    {
+        const uint64_t size = BLOCK_HEADER_SIZE + get<uint32_t>(header + 4);
+        if (offset + size > fileSize)
+        {
+            break; // torn last block
+        }
+        index.push_back({offset, size, get<uint32_t>(header + 8), get<int64_t>(header + 12), get<int64_t>(header + 20)});
+        offset += size;
+    }
+}
+
+bool BinaryTelemetryReader::isOpen() const
+{
+    return fd != -1;
+}
+
+size_t BinaryTelemetryReader::getBlockCount() const
+{
+    return index.size();
+}
+
+uint64_t BinaryTelemetryReader::getRecordCount() const
+{
+    uint64_t total = 0;
+    for (const auto &entry : index)
+    {
+        total += entry.rows;
+    }
+    return total;
+}
+
+size_t BinaryTelemetryReader::scan(int64_t fromMs, int64_t toMs,
+                                   const std::function<void(const TelemetryRecord &)> &fn)
+{
+    size_t matched = 0;
+    if (fd == -1)
+    {
+        return matched;
+    }
+    for (const auto &entry : index)
+    {
+        if (entry.maxTs < fromMs || entry.minTs > toMs)
+        {
+            continue;
+        }
+        if (!decodeBlock(entry, fromMs, toMs, fn, matched))
+        {
+            break;
+        }
+    }
+    return matched;
+}
+
+bool BinaryTelemetryReader::decodeBlock(const IndexEntry &entry, int64_t fromMs, int64_t toMs,
+                                        const std::function<void(const TelemetryRecord &)> &fn,
+                                        size_t &matched)
+{
+    block.resize(entry.size);
+    if (!preadAll(fd, block.data(), block.size(), entry.offset))
+    {
+        return false;
+    }
+
+    const char *p = block.data();
+    const char *end = p + block.size();
+    if (block.size() < BLOCK_HEADER_SIZE || std::memcmp(p, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0)
+    {
+        return false;
+    }
+    const uint32_t rows = get<uint32_t>(p + 8);
+    p += BLOCK_HEADER_SIZE;
+
+    std::vector<int64_t> timestamps(rows);
+    int64_t prev = 0;
+    for (uint32_t i = 0; i < rows; ++i)
+    {
+        uint64_t raw;
+        if (!getVarint(p, end, raw))
+        {
+            return false;
+        }
+        prev += unzigzag(raw);
+        timestamps[i] = prev;
+    }
+
+    std::vector<std::string_view> dicts[3];
+    for (auto &dict : dicts)
+    {
+        if (p >= end)
+        {
+            return false;
+        }
+        uint8_t count = static_cast<uint8_t>(*p++);
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            if (p >= end)
+            {
+                return false;
+            }
+            uint8_t len = static_cast<uint8_t>(*p++);
+            if (end - p < len)
+            {
+                return false;
+            }
+            dict.emplace_back(p, len);
+            p += len;
+        }
+    }
+
+    if (static_cast<size_t>(end - p) < static_cast<size_t>(rows) * 3 + 4)
+    {
+        return false;
+    }
+    const char *nameCodes = p;
+    const char *ctxCodes = nameCodes + rows;
+    const char *sevCodes = ctxCodes + rows;
+    p += static_cast<size_t>(rows) * 3;
+    const uint32_t bitBytes = get<uint32_t>(p);
+    p += 4;
+    if (static_cast<size_t>(end - p) < bitBytes)
+    {
+        return false;
+    }
+
+    BitReader br(p, bitBytes);
+    p += bitBytes;
+
+    // dedup summaries, in row order
+    uint64_t repeatCount;
+    if (!getVarint(p, end, repeatCount) || repeatCount > rows)
+    {
+        return false;
+    }
+    repeatRows.clear();
+    uint64_t row = 0;
+    for (uint64_t i = 0; i < repeatCount; ++i)
+    {
+        uint64_t delta, count;
+        if (!getVarint(p, end, delta) || !getVarint(p, end, count))
+        {
+            return false;
+        }
+        row += delta;
+        repeatRows.emplace_back(row, static_cast<uint32_t>(count));
+    }
+
+    std::vector<XorState> series(dicts[1].size());
+    size_t nextRepeat = 0;
+    for (uint32_t i = 0; i < rows; ++i)
+    {
+        const uint8_t nameCode = static_cast<uint8_t>(nameCodes[i]);
+        const uint8_t ctxCode = static_cast<uint8_t>(ctxCodes[i]);
+        const uint8_t sevCode = static_cast<uint8_t>(sevCodes[i]);
+        if (nameCode >= dicts[0].size() || ctxCode >= dicts[1].size() || sevCode >= dicts[2].size())
+        {
+            return false;
+        }
+
+        float value;
+        if (!decodeXor(br, series[ctxCode], value))
+        {
+            return false;
+        }
+        uint32_t repeats = 0;
+        if (nextRepeat < repeatRows.size() && repeatRows[nextRepeat].first == i)
+        {
+            repeats = repeatRows[nextRepeat++].second;
+        }
+        if (timestamps[i] < fromMs || timestamps[i] > toMs)
+        {
+            continue;
+        }
+        fn(TelemetryRecord{timestamps[i], value, dicts[0][nameCode], dicts[1][ctxCode], dicts[2][sevCode], repeats});
+        ++matched;
+    }
+    return true;
+}
@@ -0,0 +1,200 @@
+#include "binarysink.hpp"
+#include "binaryformat.hpp"
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+
+using namespace binaryformat;
+
+static std::string clip(const std::string &value)
+{
+    return value.size() > 255 ? value.substr(0, 255) : value;
+}
+
+bool binarysink::Dictionary::fits(const std::string &value) const
+{
+    return values.size() < MAX_DICTIONARY ||
+           std::find(values.begin(), values.end(), clip(value)) != values.end();
+}
+
+uint8_t binarysink::Dictionary::encode(const std::string &value)
+{
+    const std::string stored = clip(value);
+    auto it = std::find(values.begin(), values.end(), stored);
+    if (it != values.end())
+    {
+        return static_cast<uint8_t>(it - values.begin());
+    }
+    values.push_back(stored);
+    return static_cast<uint8_t>(values.size() - 1);
+}
+
+void binarysink::Dictionary::clear()
+{
+    values.clear();
+    codes.clear();
+}
+
+binarysink::binarysink(const std::string &file, size_t rowsPerBlock)
+    : rowsPerBlock(rowsPerBlock > 0 ? rowsPerBlock : 1)
+{
+    ptr = std::make_unique<std::ofstream>(file, std::ios::binary | std::ios::trunc);
+
+    std::string header(FILE_MAGIC, sizeof(FILE_MAGIC));
+    put<uint16_t>(header, VERSION);
+    put<uint16_t>(header, 0);
+    writeRaw(header);
+
+    timestamps.reserve(this->rowsPerBlock);
+    values.reserve(this->rowsPerBlock);
+}
+
+binarysink::~binarysink()
+{
+    encodeBlock();
+
+    std::string footer;
+    const uint64_t indexOffset = offset;
+    for (const auto &entry : index)
+    {
+        put<uint64_t>(footer, entry.offset);
+        put<uint32_t>(footer, entry.rows);
+        put<int64_t>(footer, entry.minTs);
+        put<int64_t>(footer, entry.maxTs);
+    }
+    put<uint64_t>(footer, indexOffset);
+    put<uint32_t>(footer, static_cast<uint32_t>(index.size()));
+    footer.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    writeRaw(footer);
+    ptr->flush();
+}
+
+void binarysink::writeRaw(const std::string &bytes)
+{
+    ptr->write(bytes.data(), bytes.size());
+    offset += bytes.size();
+}
+
+int64_t binarysink::parseTimeMs(const std::string &time)
+{
+    // "YYYY-mm-dd HH:MM:SS[.mmm]": the seconds part is parsed once per second
+    constexpr size_t SECONDS_LEN = 19;
+    const std::string seconds = time.substr(0, SECONDS_LEN);
+    if (seconds != lastTime)
+    {
+        std::tm tm{};
+        if (!strptime(seconds.c_str(), "%Y-%m-%d %H:%M:%S", &tm))
+        {
+            return lastTimeMs;
+        }
+        tm.tm_isdst = -1;
+        lastTime = seconds;
+        lastSecondMs = static_cast<int64_t>(std::mktime(&tm)) * 1000;
+    }
+
+    int64_t ms = 0;
+    if (time.size() == SECONDS_LEN + 4 && time[SECONDS_LEN] == '.')
+    {
+        std::from_chars(time.data() + SECONDS_LEN + 1, time.data() + time.size(), ms);
+    }
+    lastTimeMs = lastSecondMs + ms;
+    return lastTimeMs;
+}
+
+void binarysink::write(const logmessage &msg)
+{
+    // a value a full dictionary has no code for starts the next block
+    if (!names.fits(msg.getName()) || !contexts.fits(msg.getContext()) || !severities.fits(msg.getSeverity()))
+    {
+        encodeBlock();
+    }
+
+    if (msg.getRepeatCount() > 0)
+    {
+        repeats.emplace_back(static_cast<uint32_t>(timestamps.size()), msg.getRepeatCount());
+    }
+    timestamps.push_back(parseTimeMs(msg.getTime()));
+    values.push_back(msg.getValue());
+    names.codes.push_back(names.encode(msg.getName()));
+    contexts.codes.push_back(contexts.encode(msg.getContext()));
+    severities.codes.push_back(severities.encode(msg.getSeverity()));
+
+    if (timestamps.size() >= rowsPerBlock)
+    {
+        encodeBlock();
+    }
+}
+
+void binarysink::encodeBlock()
+{
+    if (timestamps.empty())
+    {
+        return;
+    }
+
+    const size_t rows = timestamps.size();
+    auto [minIt, maxIt] = std::minmax_element(timestamps.begin(), timestamps.end());
+
+    block.clear();
+    block.append(BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+    put<uint32_t>(block, 0); // payload size, patched below
+    put<uint32_t>(block, static_cast<uint32_t>(rows));
+    put<int64_t>(block, *minIt);
+    put<int64_t>(block, *maxIt);
+
+    int64_t prev = 0;
+    for (int64_t ts : timestamps)
+    {
+        putVarint(block, zigzag(ts - prev));
+        prev = ts;
+    }
+
+    for (const Dictionary *dict : {&names, &contexts, &severities})
+    {
+        block.push_back(static_cast<char>(dict->values.size()));
+        for (const auto &value : dict->values)
+        {
+            block.push_back(static_cast<char>(value.size()));
+            block += value;
+        }
+    }
+    for (const Dictionary *dict : {&names, &contexts, &severities})
+    {
+        block.append(reinterpret_cast<const char *>(dict->codes.data()), dict->codes.size());
+    }
+
+    // each context is its own series, so XOR against that context's previous value
+    std::string bits;
+    BitWriter bw(bits);
+    std::vector<XorState> series(contexts.values.size());
+    for (size_t i = 0; i < rows; ++i)
+    {
+        encodeXor(bw, series[contexts.codes[i]], values[i]);
+    }
+    bw.finish();
+    put<uint32_t>(block, static_cast<uint32_t>(bits.size()));
+    block += bits;
+
+    putVarint(block, repeats.size());
+    uint32_t prevRow = 0;
+    for (const auto &[row, count] : repeats)
+    {
+        putVarint(block, row - prevRow);
+        putVarint(block, count);
+        prevRow = row;
+    }
+
+    const uint32_t payloadBytes = static_cast<uint32_t>(block.size() - BLOCK_HEADER_SIZE);
+    std::memcpy(&block[sizeof(BLOCK_MAGIC)], &payloadBytes, sizeof(payloadBytes));
+
+    index.push_back({offset, static_cast<uint32_t>(rows), *minIt, *maxIt});
+    writeRaw(block);
+    ptr->flush(); // a crash loses at most the block being collected
+
+    timestamps.clear();
+    values.clear();
+    repeats.clear();
+    names.clear();
+    contexts.clear();
+    severities.clear();
+}
@@ -18,15 +18,44 @@ AppConfig loadConfig(const std::string& path)
 
     AppConfig cfg;
 
-    auto js = j["source"];
-    cfg.sourceType = js.at("type").get<std::string>();
+    auto parseSource = [](const json& js) {
+        SourceConfig sc;
+        sc.type = js.at("type").get<std::string>();
 
-    if (cfg.sourceType == "someip") {
-        if (js.contains("mapping")) {
-            cfg.mapping = js["mapping"].get<std::vector<std::string>>();
+        if (sc.type == "someip") {
+            if (js.contains("mapping")) {
+                sc.mapping = js["mapping"].get<std::vector<std::string>>();
+            }
+            sc.mode = js.value("mode", std::string("event"));
+            sc.outstanding = js.value("outstanding", 4);
+            sc.timeoutMs = js.value("timeout_ms", 1000);
+            sc.requestMs = js.value("request_ms", 250);
+            sc.perCore = js.value("per_core", std::string("alerts"));
+        } else if (sc.type == "shm") {
+            sc.path = js.value("path", std::string("telemetry"));
+            sc.perCore = js.value("per_core", std::string("alerts"));
+        } else {
+            sc.policy = js.value("policy", "cpu");
+            bool isFile = sc.type == "file" || sc.type == "mmap";
+            sc.path = js.value("path", isFile ? std::string("telemetry.txt")
+                                              : std::string("/tmp/telemetry.sock"));
+            sc.framing = js.value("framing", std::string("newline"));
+            sc.follow = js.value("follow", false);
+            sc.offsetFile = js.value("offset_file", std::string());
+            sc.replayRate = js.value("replay_rate", 0.0);
+            sc.address = js.value("address", std::string("127.0.0.1:5140"));
+            sc.shards = js.value("shards", 1);
+        }
+        return sc;
+    };
+
+    // "sources" lists several sources; the single "source" object is still accepted
+    if (j.contains("sources")) {
+        for (const auto& js : j["sources"]) {
+            cfg.sources.push_back(parseSource(js));
         }
     } else {
-        cfg.policy = js.value("policy", "cpu");
+        cfg.sources.push_back(parseSource(j["source"]));
     }
 
     auto sk = j["sinks"];
@@ -34,9 +63,34 @@ AppConfig loadConfig(const std::string& path)
     cfg.sinkCpuFile = sk.value("cpu_file", true);
     cfg.sinkRamFile = sk.value("ram_file", true);
     cfg.sinkTempFile = sk.value("temp_file", true);
+    cfg.sinkBinaryFile = sk.value("binary_file", false);
+    cfg.sinkShm = sk.value("shm", std::string());
+
+    if (j.contains("async")) {
+        auto as = j["async"];
+        cfg.asyncSinks     = as.value("enabled", true);
+        cfg.asyncQueueSize = as.value("queue_size", static_cast<size_t>(1024));
+        cfg.asyncOverflow  = as.value("overflow", std::string("block"));
+        cfg.asyncBlockMs   = as.value("block_ms", 200);
+        if (as.contains("sink_overflow")) {
+            for (const auto& [sink, policy] : as["sink_overflow"].items()) {
+                cfg.asyncSinkOverflow[sink] = policy.get<std::string>();
+            }
+        }
+    }
+
+    if (j.contains("filter")) {
+        auto fl = j["filter"];
+        cfg.filterDedup    = fl.value("dedup", false);
+        cfg.infoPerSec     = fl.value("info_per_sec", 0.0);
+        cfg.warningPerSec  = fl.value("warning_per_sec", 0.0);
+        cfg.criticalPerSec = fl.value("critical_per_sec", 0.0);
+        cfg.rateBurst      = fl.value("burst", 10.0);
+        cfg.infoSampleRate = fl.value("info_sample_rate", 1.0);
+    }
 
     auto rt = j["rates"];
-    cfg.parseMs = rt.value("parse_ms", 0);
+    cfg.parseMs = rt.value("parse_ms", 10);
     cfg.logMs   = rt.value("log_ms", 0);
 
     return cfg;
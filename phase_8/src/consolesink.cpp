@@ -1,7 +1,194 @@
 #include "consolesink.hpp"
 #include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-void consolesink::write(const logmessage& str)
+namespace
 {
-    std::cout << str << std::endl;
+    const char *severityColor(const std::string &severity)
+    {
+        if (severity == "CRITICAL")
+            return "\033[1;31m";
+        if (severity == "WARNING")
+            return "\033[33m";
+        return "\033[32m";
+    }
+    constexpr const char *COLOR_RESET = "\033[0m";
+    constexpr int DRAIN_TIMEOUT_MS = 1000;   // how long the destructor waits for a stuck stdout
+}
+
+consolesink::consolesink()
+    : consolesink(isatty(STDOUT_FILENO) == 1)
+{
+}
+
+consolesink::consolesink(bool useColors, size_t maxPendingBytes)
+    : colors(useColors), maxPendingBytes(maxPendingBytes)
+{
+    pending.reserve(maxPendingBytes ? maxPendingBytes : 4096);
+    openStdout();
+}
+
+consolesink::~consolesink()
+{
+    // last chance: give stdout a bounded time to take what is still queued
+    int waited = 0;
+    while (!pending.empty() && outFd != -1)
+    {
+        ssize_t n = writeSome(pending.data(), pending.size());
+        if (n > 0)
+        {
+            pending.erase(0, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && waited < DRAIN_TIMEOUT_MS)
+        {
+            pollfd pfd{outFd, POLLOUT, 0};
+            poll(&pfd, 1, 100);
+            waited += 100;
+            continue;
+        }
+        break;
+    }
+    if (outFd != -1)
+        ::close(outFd);
+}
+
+void consolesink::openStdout()
+{
+    struct stat st;
+    if (fstat(STDOUT_FILENO, &st) != 0)
+        return;
+
+    if (S_ISREG(st.st_mode))
+    {
+        // writes to a regular file never wait; sharing fd 1's offset keeps std::cout in order
+        outFd = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0);
+        return;
+    }
+
+    // a new open file description for the same pipe or terminal, so O_NONBLOCK
+    // does not leak to fd 1 (a dup would share the flag with std::cout)
+    outFd = ::open("/proc/self/fd/1", O_WRONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    if (outFd != -1)
+        return;
+
+    // sockets cannot be reopened; send(MSG_DONTWAIT) gives the same per call
+    outFd = fcntl(STDOUT_FILENO, F_DUPFD_CLOEXEC, 0);
+    outIsSocket = S_ISSOCK(st.st_mode);
+}
+
+ssize_t consolesink::writeSome(const char *data, size_t size)
+{
+    if (outIsSocket)
+        return ::send(outFd, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    return ::write(outFd, data, size);
+}
+
+void consolesink::appendLine(const logmessage &msg)
+{
+    const std::string severity = msg.getSeverity();
+
+    pending += '[';
+    pending += msg.getTime();
+    pending += "] [";
+    if (colors)
+    {
+        pending += severityColor(severity);
+        pending += severity;
+        pending += COLOR_RESET;
+    }
+    else
+    {
+        pending += severity;
+    }
+    pending += "] ";
+    pending += msg.getName();
+    pending += " (";
+    pending += msg.getContext();
+    pending += "): ";
+    pending += msg.getText();
+    pending += '\n';
+}
+
+void consolesink::write(const logmessage &str)
+{
+    // stdout is gone (see flush()); nothing queued here would ever be written
+    if (outFd == -1)
+    {
+        ++dropped;
+        return;
+    }
+
+    // while stdout cannot keep up, shed INFO first and keep anomalies up to twice the budget
+    if (backlogged && maxPendingBytes != 0 && pending.size() >= maxPendingBytes)
+    {
+        if (str.getSeverity() == "INFO" || pending.size() >= 2 * maxPendingBytes)
+        {
+            ++dropped;
+            ++droppedSinceReport;
+            return;
+        }
+    }
+    appendLine(str);
+}
+
+void consolesink::flush()
+{
+    if (pending.empty() || outFd == -1)
+        return;
+
+    if (droppedSinceReport != 0)
+    {
+        pending += "[consolesink] stdout too slow, dropped ";
+        pending += std::to_string(droppedSinceReport);
+        pending += " messages\n";
+        droppedSinceReport = 0;
+    }
+
+    // status lines the app printed through std::cout go out before this batch
+    std::cout.flush();
+
+    ssize_t n = writeSome(pending.data(), pending.size());
+    if (n < 0)
+    {
+        // EAGAIN: the pipe or terminal is full, keep the batch for the next flush
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            backlogged = true;
+            return;
+        }
+        // EPIPE (reader gone, e.g. "| head"), EBADF, EIO: stdout will not come back
+        std::cerr << "[consolesink] stdout failed (" << std::strerror(errno) << "), console output disabled\n";
+        ::close(outFd);
+        outFd = -1;
+        pending.clear();
+        pending.shrink_to_fit();
+        backlogged = false;
+        return;
+    }
+
+    if (static_cast<size_t>(n) == pending.size())
+    {
+        pending.clear();
+        backlogged = false;
+    }
+    else
+    {
+        // short write: the reader is slower than us
+        pending.erase(0, static_cast<size_t>(n));
+        backlogged = true;
+    }
+}
+
+size_t consolesink::getDroppedCount() const
+{
+    return dropped;
 }
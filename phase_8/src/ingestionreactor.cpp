@@ -0,0 +1,166 @@
+#include "ingestionreactor.hpp"
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <iostream>
+
+IngestionReactor::IngestionReactor(int pollIntervalMs)
+    : epollFd(epoll_create1(EPOLL_CLOEXEC)),
+      wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      pollIntervalMs(pollIntervalMs < MIN_POLL_INTERVAL_MS ? MIN_POLL_INTERVAL_MS : pollIntervalMs)
+{
+    if (epollFd != -1 && wakeFd != -1)
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = WAKE_TOKEN;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+    }
+}
+
+IngestionReactor::~IngestionReactor()
+{
+    if (wakeFd != -1)
+    {
+        close(wakeFd);
+    }
+    if (epollFd != -1)
+    {
+        close(epollFd);
+    }
+}
+
+bool IngestionReactor::addSource(ITelemetrySource &source, RecordHandler handler)
+{
+    if (epollFd == -1 || !source.OpenSource())
+    {
+        return false;
+    }
+
+    Entry entry{&source, std::move(handler), false, true};
+
+    int fd = source.getFd();
+    if (fd != -1 && source.setNonBlocking())
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u64 = entries.size();
+        // regular files are rejected by epoll (EPERM) and fall back to polling
+        entry.pollable = (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0);
+    }
+
+    entries.push_back(std::move(entry));
+    ++activeCount;
+    return true;
+}
+
+void IngestionReactor::deactivate(size_t idx)
+{
+    Entry &entry = entries[idx];
+    if (!entry.active)
+    {
+        return;
+    }
+    if (entry.pollable)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, entry.source->getFd(), nullptr);
+    }
+    entry.active = false;
+    --activeCount;
+}
+
+bool IngestionReactor::service(size_t idx)
+{
+    Entry &entry = entries[idx];
+    records.clear();
+    ReadStatus status = entry.source->ReadAvailable(records);
+
+    for (const auto &record : records)
+    {
+        entry.handler(record);
+    }
+    if (status == ReadStatus::CLOSED)
+    {
+        deactivate(idx);
+    }
+    return status == ReadStatus::OK && !records.empty();
+}
+
+void IngestionReactor::run()
+{
+    constexpr int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    auto lastPoll = std::chrono::steady_clock::time_point{};
+    const auto interval = std::chrono::milliseconds(pollIntervalMs);
+    bool pollAgain = false; // a polled source returned records and may have more (e.g. a file backlog)
+
+    while (!stopping.load(std::memory_order_acquire) && activeCount > 0)
+    {
+        bool hasPolled = false;
+        for (const auto &entry : entries)
+        {
+            hasPolled |= (entry.active && !entry.pollable);
+        }
+
+        // with nothing to catch up on, sleep until the next poll instead of spinning
+        int timeout = -1;
+        if (hasPolled && pollAgain)
+        {
+            timeout = 0;
+        }
+        else if (hasPolled)
+        {
+            auto due = lastPoll + interval;
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(due - std::chrono::steady_clock::now());
+            timeout = wait.count() > 0 ? static_cast<int>(wait.count()) : 0;
+        }
+
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
+        if (n < 0 && errno != EINTR)
+        {
+            std::cerr << "[REACTOR] epoll_wait failed\n";
+            break;
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            if (events[i].data.u64 == WAKE_TOKEN)
+            {
+                uint64_t drain;
+                (void)!read(wakeFd, &drain, sizeof(drain));
+                continue;
+            }
+            size_t idx = static_cast<size_t>(events[i].data.u64);
+            if (idx < entries.size() && entries[idx].active)
+            {
+                service(idx);
+            }
+        }
+
+        if (hasPolled && (pollAgain || std::chrono::steady_clock::now() >= lastPoll + interval))
+        {
+            lastPoll = std::chrono::steady_clock::now();
+            pollAgain = false;
+            for (size_t idx = 0; idx < entries.size(); ++idx)
+            {
+                if (entries[idx].active && !entries[idx].pollable)
+                {
+                    pollAgain |= service(idx);
+                }
+            }
+        }
+    }
+}
+
+void IngestionReactor::stop()
+{
+    stopping.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    (void)!write(wakeFd, &one, sizeof(one));
+}
+
+size_t IngestionReactor::getActiveCount() const
+{
+    return activeCount;
+}
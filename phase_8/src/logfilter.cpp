@@ -0,0 +1,133 @@
+#include "logfilter.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+    const std::string REPEAT_PREFIX = "previous message repeated ";
+}
+
+bool LogFilterOptions::enabled() const
+{
+    bool limited = std::any_of(ratePerSec.begin(), ratePerSec.end(), [](double r)
+                               { return r > 0.0; });
+    return dedup || limited || infoSampleRate < 1.0;
+}
+
+LogFilter::LogFilter(const LogFilterOptions &options)
+    : options(options), rng(std::random_device{}())
+{
+}
+
+logmessage LogFilter::repeatSummary(const logmessage &last, size_t repeats)
+{
+    logmessage summary(last.getName(),
+                       last.getTime(),
+                       last.getContext(),
+                       last.getSeverity(),
+                       REPEAT_PREFIX + std::to_string(repeats) + " times");
+    summary.setValue(last.getValue());
+    // flagged on the message itself, so a real line with the same wording is never taken for one
+    summary.setRepeatCount(static_cast<uint32_t>(std::min<size_t>(repeats, UINT32_MAX)));
+    return summary;
+}
+
+bool LogFilter::takeToken(TokenBucket &bucket, double rate)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (!bucket.primed)
+    {
+        bucket.tokens = options.burst;
+        bucket.last = now;
+        bucket.primed = true;
+    }
+
+    std::chrono::duration<double> elapsed = now - bucket.last;
+    bucket.last = now;
+    bucket.tokens = std::min(options.burst, bucket.tokens + elapsed.count() * rate);
+
+    if (bucket.tokens < 1.0)
+    {
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+void LogFilter::process(const logmessage &msg, std::vector<logmessage> &out)
+{
+    auto ctx = magic_enum::enum_cast<TelemetrySrc_enum>(msg.getContext());
+    auto sev = magic_enum::enum_cast<SeverityLvl_enum>(msg.getSeverity()).value_or(SeverityLvl_enum::INFO);
+    ContextState &state = contexts[ctx ? *magic_enum::enum_index(*ctx) : CONTEXT_SLOTS - 1];
+
+    if (options.dedup)
+    {
+        if (state.last &&
+            state.last->getText() == msg.getText() &&
+            state.last->getSeverity() == msg.getSeverity() &&
+            state.last->getName() == msg.getName())
+        {
+            ++state.repeats;
+            ++suppressed;
+            state.last->setTime(msg.getTime());
+            if (state.repeats >= options.dedupMaxRepeat)
+            {
+                out.push_back(repeatSummary(*state.last, state.repeats));
+                state.repeats = 0;
+            }
+            return;
+        }
+
+        if (state.repeats > 0)
+        {
+            out.push_back(repeatSummary(*state.last, state.repeats));
+            state.repeats = 0;
+        }
+        // a run starts only once its first line is actually written (below)
+        state.last.reset();
+    }
+
+    if (sev == SeverityLvl_enum::INFO && options.infoSampleRate < 1.0 &&
+        coin(rng) >= options.infoSampleRate)
+    {
+        ++suppressed;
+        return;
+    }
+
+    size_t sevSlot = *magic_enum::enum_index(sev);
+    double rate = options.ratePerSec[sevSlot];
+    if (rate > 0.0 && !takeToken(state.buckets[sevSlot], rate))
+    {
+        ++suppressed;
+        return;
+    }
+
+    if (options.dedup)
+    {
+        state.last = msg;
+    }
+    out.push_back(msg);
+}
+
+void LogFilter::drain(std::vector<logmessage> &out)
+{
+    for (auto &state : contexts)
+    {
+        if (state.last && state.repeats > 0)
+        {
+            out.push_back(repeatSummary(*state.last, state.repeats));
+        }
+        state.repeats = 0;
+        state.last.reset();
+    }
+}
+
+bool LogFilter::isRepeatSummary(const logmessage &msg)
+{
+    return msg.getRepeatCount() > 0;
+}
+
+uint64_t LogFilter::getSuppressedCount() const
+{
+    return suppressed;
+}
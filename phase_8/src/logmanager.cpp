@@ -1,5 +1,6 @@
 #include "logmanager.hpp"
 #include <iostream>
+#include <stdexcept>
 #include <unistd.h>
 
 LogManager::LogManager(size_t bufferCapacity)
@@ -7,14 +8,108 @@ LogManager::LogManager(size_t bufferCapacity)
 {
 }
 
-void LogManager::addSink(Ilogsink *sink)
+void LogManager::addSink(Ilogsink *sink, const SinkRoute &route)
 {
+    if (currentSink.size() >= MAX_SINKS)
+    {
+        throw std::length_error("LogManager supports at most 64 sinks");
+    }
     currentSink.push_back(sink);
+    routes.push_back(route);
+    asyncSinks.emplace_back();
+    compileRoutes();
+}
+
+void LogManager::addAsyncSink(Ilogsink *sink, const AsyncSinkOptions &options, const SinkRoute &route)
+{
+    auto wrapper = std::make_unique<asyncsink>(sink, options);
+    addSink(wrapper.get(), route);
+    asyncSinks.back() = std::move(wrapper);
+}
+
+void LogManager::compileRoutes()
+{
+    for (auto &row : routeTable)
+    {
+        row.fill(0);
+    }
+
+    for (size_t i = 0; i < routes.size(); ++i)
+    {
+        const SinkRoute &route = routes[i];
+        const size_t floor = magic_enum::enum_integer(route.minSeverity);
+
+        for (size_t ctx = 0; ctx < CONTEXT_SLOTS; ++ctx)
+        {
+            // the unknown-context slot only feeds sinks that do not filter on context
+            bool ctxMatch = !route.context ||
+                            (ctx < CONTEXT_SLOTS - 1 &&
+                             magic_enum::enum_index(*route.context) == ctx);
+            if (!ctxMatch)
+            {
+                continue;
+            }
+            // SeverityLvl_enum is ordered CRITICAL < WARNING < INFO
+            for (size_t sev = 0; sev <= floor && sev < SEVERITY_SLOTS; ++sev)
+            {
+                routeTable[ctx][sev] |= (uint64_t{1} << i);
+            }
+        }
+    }
+}
+
+void LogManager::dispatch(const logmessage &msg)
+{
+    auto ctx = magic_enum::enum_cast<TelemetrySrc_enum>(msg.getContext());
+    auto sev = magic_enum::enum_cast<SeverityLvl_enum>(msg.getSeverity());
+
+    size_t ctxSlot = ctx ? *magic_enum::enum_index(*ctx) : CONTEXT_SLOTS - 1;
+    size_t sevSlot = magic_enum::enum_index(sev.value_or(SeverityLvl_enum::INFO)).value();
+
+    uint64_t mask = routeTable[ctxSlot][sevSlot];
+    while (mask)
+    {
+        size_t i = static_cast<size_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+
+        const std::string &name = routes[i].name;
+        if (name.empty() || name == msg.getName())
+        {
+            currentSink[i]->write(msg);
+        }
+    }
+}
+
+void LogManager::setFilter(const LogFilterOptions &options)
+{
+    filter = LogFilter(options);
+    filtering = options.enabled();
 }
 
 void LogManager::log(const logmessage &msg)
 {
-    messageBuffer.tryPush(msg);
+    if (!filtering)
+    {
+        messageBuffer.tryPush(msg);
+        return;
+    }
+
+    filtered.clear();
+    filter.process(msg, filtered);
+    for (auto &out : filtered)
+    {
+        messageBuffer.tryPush(std::move(out));
+    }
+}
+
+void LogManager::flushSuppressed()
+{
+    filtered.clear();
+    filter.drain(filtered);
+    for (auto &out : filtered)
+    {
+        messageBuffer.tryPush(std::move(out));
+    }
 }
 
 void LogManager::flush()
@@ -24,12 +119,13 @@ void LogManager::flush()
         auto msgOpt = messageBuffer.tryPop();
         if (msgOpt)
         {
-            for (auto &sink : currentSink)
-            {
-                sink->write(*msgOpt);
-            }
+            dispatch(*msgOpt);
         }
     }
+    for (auto &sink : currentSink)
+    {
+        sink->flush();
+    }
 }
 
 void LogManager::clear()
@@ -47,6 +143,22 @@ bool LogManager::isEmpty() const
     return messageBuffer.isEmpty();
 }
 
+std::vector<uint64_t> LogManager::getDroppedCounts() const
+{
+    std::vector<uint64_t> counts;
+    counts.reserve(asyncSinks.size());
+    for (const auto &wrapper : asyncSinks)
+    {
+        counts.push_back(wrapper ? wrapper->getDroppedCount() : 0);
+    }
+    return counts;
+}
+
+uint64_t LogManager::getSuppressedCount() const
+{
+    return filter.getSuppressedCount();
+}
+
 logmanagerbuilder::logmanagerbuilder(size_t bufferCapacity) : bufferCapacity(bufferCapacity)
 {
 }
@@ -56,17 +168,35 @@ logmanagerbuilder &logmanagerbuilder::setBufferCapacity(size_t capacity)
     bufferCapacity = capacity;
     return *this;
 }
-logmanagerbuilder &logmanagerbuilder::addSink(Ilogsink *sink)
+logmanagerbuilder &logmanagerbuilder::setFilter(const LogFilterOptions &options)
+{
+    filterOptions = options;
+    return *this;
+}
+logmanagerbuilder &logmanagerbuilder::addSink(Ilogsink *sink, const SinkRoute &route)
+{
+    sinks.push_back({sink, route, std::nullopt});
+    return *this;
+}
+logmanagerbuilder &logmanagerbuilder::addAsyncSink(Ilogsink *sink, const AsyncSinkOptions &options, const SinkRoute &route)
 {
-    sinks.push_back(sink);
+    sinks.push_back({sink, route, options});
     return *this;
 }
 LogManager logmanagerbuilder::build()
 {
     LogManager manager(bufferCapacity);
-    for (auto &sink : sinks)
+    manager.setFilter(filterOptions);
+    for (auto &entry : sinks)
     {
-        manager.addSink(sink);
+        if (entry.async)
+        {
+            manager.addAsyncSink(entry.sink, *entry.async, entry.route);
+        }
+        else
+        {
+            manager.addSink(entry.sink, entry.route);
+        }
     }
     return manager;
 }
\ No newline at end of file
@@ -40,6 +40,11 @@ std::string logmessage::getText() const
     return text;
 }
 
+float logmessage::getValue() const
+{
+    return value;
+}
+
 void logmessage::setName(const std::string& n) 
 {
     name = n;
@@ -64,6 +69,21 @@ void logmessage::setText(const std::string& txt)
     text = txt;
 }
 
+void logmessage::setValue(float v)
+{
+    value = v;
+}
+
+uint32_t logmessage::getRepeatCount() const
+{
+    return repeats;
+}
+
+void logmessage::setRepeatCount(uint32_t n)
+{
+    repeats = n;
+}
+
 
 std::ostream& operator<<(std::ostream& os , const logmessage& msg)
  {
@@ -0,0 +1,136 @@
+#include "recordframer.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+
+RecordFramer::RecordFramer(FramingMode mode, size_t capacity)
+    : mode(mode), buffer(capacity > 0 ? capacity : 1)
+{
+}
+
+void RecordFramer::reclaim()
+{
+    if (begin == end)
+    {
+        begin = end = 0;
+        return;
+    }
+    if (begin > 0)
+    {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+    if (end == buffer.size())
+    {
+        if (buffer.size() < MAX_FRAME + 4)
+        {
+            buffer.resize(std::min(buffer.size() * 2, MAX_FRAME + 4));
+        }
+        else if (mode == FramingMode::NEWLINE)
+        {
+            // a line longer than MAX_FRAME is garbage; resynchronise on the next newline
+            ++framingErrors;
+            skipping = true;
+            begin = end = 0;
+        }
+    }
+}
+
+char *RecordFramer::tail()
+{
+    return buffer.data() + end;
+}
+
+size_t RecordFramer::tailSpace() const
+{
+    return buffer.size() - end;
+}
+
+void RecordFramer::commit(size_t n)
+{
+    end += n;
+}
+
+bool RecordFramer::split(std::vector<std::string_view> &out)
+{
+    const char *data = buffer.data();
+
+    if (mode == FramingMode::NEWLINE)
+    {
+        while (begin < end)
+        {
+            // glibc memchr is vectorised, so this scans 16-32 bytes per step
+            const char *nl = static_cast<const char *>(std::memchr(data + begin, '\n', end - begin));
+            if (!nl)
+            {
+                if (skipping)
+                {
+                    begin = end;
+                }
+                break;
+            }
+            size_t pos = static_cast<size_t>(nl - data);
+            size_t stop = (pos > begin && data[pos - 1] == '\r') ? pos - 1 : pos;
+            if (!skipping && stop > begin)
+            {
+                out.emplace_back(data + begin, stop - begin);
+            }
+            skipping = false;
+            begin = pos + 1;
+        }
+        return true;
+    }
+
+    while (end - begin >= 4)
+    {
+        uint32_t len;
+        std::memcpy(&len, data + begin, sizeof(len));
+        len = ntohl(len);
+        if (len > MAX_FRAME)
+        {
+            // a length-prefixed stream cannot be resynchronised
+            ++framingErrors;
+            begin = end;
+            return false;
+        }
+        if (end - begin - 4 < len)
+        {
+            break;
+        }
+        out.emplace_back(data + begin + 4, len);
+        begin += 4 + len;
+    }
+    return true;
+}
+
+bool RecordFramer::takePartial(std::vector<std::string_view> &out)
+{
+    if (mode != FramingMode::NEWLINE || skipping || begin == end)
+    {
+        return false;
+    }
+    size_t stop = (buffer[end - 1] == '\r') ? end - 1 : end;
+    if (stop > begin)
+    {
+        out.emplace_back(buffer.data() + begin, stop - begin);
+    }
+    begin = end;
+    return true;
+}
+
+void RecordFramer::clear()
+{
+    begin = end = 0;
+    skipping = false;
+}
+
+size_t RecordFramer::buffered() const
+{
+    return end - begin;
+}
+
+uint64_t RecordFramer::getFramingErrors() const
+{
+    return framingErrors;
+}
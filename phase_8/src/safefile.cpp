@@ -34,6 +34,14 @@ int safefile::Read(char *buffer, int buffer_size)
 {
     return read(fd, buffer, buffer_size);
 }
+off_t safefile::Seek(off_t offset, int whence)
+{
+    return lseek(fd, offset, whence);
+}
+int safefile::getFd() const
+{
+    return fd;
+}
 bool safefile::isOpen ()const
 {
     if (fd == -1)
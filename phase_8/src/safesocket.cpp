@@ -1,5 +1,6 @@
 #include "safesocket.hpp"
 #include <sys/socket.h>
+#include <fcntl.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <cstring>
@@ -72,6 +73,16 @@ bool SafeSocket::isOpen() const
     return fd_ != -1;
 }
 
+bool SafeSocket::setNonBlocking()
+{
+    if (fd_ == -1)
+    {
+        return false;
+    }
+    int flags = fcntl(fd_, F_GETFL, 0);
+    return flags != -1 && fcntl(fd_, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
 ssize_t SafeSocket::Read(char *buffer, size_t count)
 {
     ssize_t readbytes = read(fd_, buffer, count);
@@ -0,0 +1,397 @@
+#include "shmring.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <linux/futex.h>
+#include <new>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+std::string shmRingName(const std::string &name)
+{
+    size_t start = name.find_first_not_of('/');
+    return "/" + (start == std::string::npos ? std::string() : name.substr(start));
+}
+
+static size_t segmentSize(uint32_t capacity)
+{
+    return sizeof(ShmRingHeader) + static_cast<size_t>(capacity) * sizeof(ShmRingSlot);
+}
+
+// shared (not FUTEX_PRIVATE) futex ops: the word lives in a segment mapped by other processes
+static long futexCall(const std::atomic<uint32_t> *word, int op, uint32_t value, const timespec *timeout)
+{
+    return syscall(SYS_futex, reinterpret_cast<const uint32_t *>(word), op, value, timeout, nullptr, 0);
+}
+
+// ---------------- record ----------------
+
+ShmRecord ShmRecord::make(uint64_t timestampMs, TelemetrySrc_enum context, SeverityLvl_enum severity,
+                          std::string_view label, float value)
+{
+    ShmRecord record;
+    record.timestampMs = timestampMs;
+    record.value = value;
+    record.context = static_cast<uint8_t>(*magic_enum::enum_index(context));
+    record.severity = static_cast<uint8_t>(*magic_enum::enum_index(severity));
+    record.labelLen = static_cast<uint8_t>(std::min(label.size(), sizeof(record.label)));
+    std::memcpy(record.label, label.data(), record.labelLen);
+    return record;
+}
+
+TelemetrySrc_enum ShmRecord::getContext() const
+{
+    return magic_enum::enum_cast<TelemetrySrc_enum>(context).value_or(TelemetrySrc_enum::CPU);
+}
+
+SeverityLvl_enum ShmRecord::getSeverity() const
+{
+    return magic_enum::enum_cast<SeverityLvl_enum>(severity).value_or(SeverityLvl_enum::INFO);
+}
+
+// ---------------- writer ----------------
+
+ShmRingWriter::ShmRingWriter(const std::string &name, uint32_t capacity)
+    : name(shmRingName(name)),
+      capacity(std::max<uint32_t>(capacity, 1))
+{
+    // a leftover segment may still be mapped by readers of a previous run; they see it unlinked
+    shm_unlink(this->name.c_str());
+
+    int fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        std::cerr << "[SHM] Cannot create shared memory " << this->name << ": " << std::strerror(errno) << "\n";
+        return;
+    }
+
+    mapSize = segmentSize(this->capacity);
+    void *map = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(mapSize)) == 0)
+    {
+        map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd); // the mapping keeps the segment alive
+    if (map == MAP_FAILED)
+    {
+        std::cerr << "[SHM] Cannot map shared memory " << this->name << ": " << std::strerror(errno) << "\n";
+        shm_unlink(this->name.c_str());
+        mapSize = 0;
+        return;
+    }
+
+    // ftruncate zero-fills, so every slot starts with seq 0 (never a complete record)
+    header = new (map) ShmRingHeader();
+    header->version = ShmRingHeader::VERSION;
+    header->recordSize = sizeof(ShmRecord);
+    header->capacity = this->capacity;
+    header->wakeSeq.store(0, std::memory_order_relaxed);
+    header->head.store(0, std::memory_order_relaxed);
+    slots = reinterpret_cast<ShmRingSlot *>(static_cast<char *>(map) + sizeof(ShmRingHeader));
+    for (uint32_t i = 0; i < this->capacity; ++i)
+    {
+        new (&slots[i]) ShmRingSlot();
+    }
+    header->magic.store(ShmRingHeader::MAGIC, std::memory_order_release);
+}
+
+ShmRingWriter::~ShmRingWriter()
+{
+    if (header)
+    {
+        // unlink first, so woken readers already see the segment as stale
+        shm_unlink(name.c_str());
+        notify();
+        munmap(header, mapSize);
+    }
+}
+
+void ShmRingWriter::publish(const ShmRecord &record)
+{
+    if (!header)
+    {
+        return;
+    }
+
+    uint64_t words[ShmRingSlot::WORDS];
+    std::memcpy(words, &record, sizeof(record));
+
+    ShmRingSlot &slot = slots[next % capacity];
+    slot.seq.store(2 * next + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < ShmRingSlot::WORDS; ++i)
+    {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * next + 2, std::memory_order_release);
+
+    ++next;
+    header->head.store(next, std::memory_order_release);
+}
+
+void ShmRingWriter::notify()
+{
+    if (!header)
+    {
+        return;
+    }
+    header->wakeSeq.fetch_add(1, std::memory_order_release);
+    futexCall(&header->wakeSeq, FUTEX_WAKE, INT_MAX, nullptr);
+}
+
+// ---------------- reader ----------------
+
+ShmRingReader::ShmRingReader(const std::string &name)
+    : name(shmRingName(name))
+{
+}
+
+ShmRingReader::~ShmRingReader()
+{
+    close();
+}
+
+void ShmRingReader::close()
+{
+    if (header)
+    {
+        munmap(const_cast<ShmRingHeader *>(header), mapSize);
+    }
+    if (fd != -1)
+    {
+        ::close(fd);
+    }
+    header = nullptr;
+    slots = nullptr;
+    fd = -1;
+    mapSize = 0;
+}
+
+bool ShmRingReader::open(bool backlog)
+{
+    close();
+
+    fd = shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd == -1)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader))
+    {
+        close();
+        return false;
+    }
+
+    mapSize = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        mapSize = 0;
+        close();
+        return false;
+    }
+    header = static_cast<const ShmRingHeader *>(map);
+
+    if (header->magic.load(std::memory_order_acquire) != ShmRingHeader::MAGIC ||
+        header->version != ShmRingHeader::VERSION || header->recordSize != sizeof(ShmRecord) ||
+        header->capacity == 0 || segmentSize(header->capacity) > mapSize)
+    {
+        close();
+        return false;
+    }
+    capacity = header->capacity;
+    slots = reinterpret_cast<const ShmRingSlot *>(static_cast<const char *>(map) + sizeof(ShmRingHeader));
+
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    cursor = (backlog && head > capacity) ? head - capacity : (backlog ? 0 : head);
+    return true;
+}
+
+size_t ShmRingReader::read(std::vector<ShmRecord> &out, size_t max)
+{
+    if (!header)
+    {
+        return 0;
+    }
+
+    size_t n = 0;
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    while (cursor < head && n < max)
+    {
+        // fell more than a lap behind: everything before the oldest live slot is gone
+        if (head - cursor > capacity)
+        {
+            lost += head - capacity - cursor;
+            cursor = head - capacity;
+        }
+
+        const ShmRingSlot &slot = slots[cursor % capacity];
+        const uint64_t complete = 2 * cursor + 2;
+        uint64_t words[ShmRingSlot::WORDS];
+
+        uint64_t before = slot.seq.load(std::memory_order_acquire);
+        for (size_t i = 0; i < ShmRingSlot::WORDS; ++i)
+        {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = slot.seq.load(std::memory_order_relaxed);
+
+        if (before == complete && after == complete)
+        {
+            ShmRecord record;
+            std::memcpy(&record, words, sizeof(record));
+            out.push_back(record);
+            ++n;
+        }
+        else
+        {
+            ++lost; // overwritten while we were copying it
+            head = header->head.load(std::memory_order_acquire);
+        }
+        ++cursor;
+    }
+    return n;
+}
+
+bool ShmRingReader::isStale() const
+{
+    struct stat st;
+    return fd == -1 || fstat(fd, &st) != 0 || st.st_nlink == 0;
+}
+
+uint64_t ShmRingReader::getHead() const
+{
+    return header ? header->head.load(std::memory_order_acquire) : 0;
+}
+
+bool ShmRingReader::waitForWrite(uint64_t seenHead, int timeoutMs) const
+{
+    if (!header)
+    {
+        return false;
+    }
+
+    // read the futex word before the head, so a notify() in between makes the wait return at once
+    uint32_t seq = header->wakeSeq.load(std::memory_order_acquire);
+    if (header->head.load(std::memory_order_acquire) != seenHead)
+    {
+        return true;
+    }
+    timespec timeout{timeoutMs / 1000, static_cast<long>(timeoutMs % 1000) * 1000000};
+    futexCall(&header->wakeSeq, FUTEX_WAIT, seq, &timeout);
+    return header->head.load(std::memory_order_acquire) != seenHead;
+}
+
+// ---------------- waiter ----------------
+
+ShmRingWaiter::ShmRingWaiter(const std::string &name)
+    : ring(name)
+{
+}
+
+ShmRingWaiter::~ShmRingWaiter()
+{
+    stop();
+    if (eventFd != -1)
+    {
+        close(eventFd);
+    }
+}
+
+bool ShmRingWaiter::start()
+{
+    std::lock_guard<std::mutex> lock(stopMtx);
+    if (running)
+    {
+        return true;
+    }
+    if (eventFd == -1)
+    {
+        eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFd == -1)
+        {
+            std::cerr << "[SHM] eventfd failed: " << std::strerror(errno) << "\n";
+            return false;
+        }
+    }
+    running = true;
+    thread = std::thread(&ShmRingWaiter::run, this);
+    return true;
+}
+
+void ShmRingWaiter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(stopMtx);
+        if (!running)
+        {
+            return;
+        }
+        running = false;
+    }
+    stopCv.notify_all();
+    thread.join();   // a futex wait in progress ends within WAIT_TIMEOUT_MS
+}
+
+void ShmRingWaiter::signal()
+{
+    uint64_t one = 1;
+    (void)!write(eventFd, &one, sizeof(one));
+}
+
+void ShmRingWaiter::clear()
+{
+    uint64_t count;
+    (void)!read(eventFd, &count, sizeof(count));
+}
+
+void ShmRingWaiter::run()
+{
+    uint64_t signalled = 0;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(stopMtx);
+            if (!running)
+            {
+                return;
+            }
+        }
+
+        if (!ring.isOpen() || ring.isStale())
+        {
+            if (ring.open())
+            {
+                signalled = ring.getHead();
+                signal();   // a new ring: the consumer re-attaches
+                continue;
+            }
+            // keep nudging the consumer until a ring is there
+            signal();
+            std::unique_lock<std::mutex> lock(stopMtx);
+            if (stopCv.wait_for(lock, std::chrono::milliseconds(REOPEN_EVERY_MS), [this] { return !running; }))
+            {
+                return;
+            }
+            continue;
+        }
+
+        uint64_t head = ring.getHead();
+        if (head != signalled)
+        {
+            signalled = head;
+            signal();
+        }
+        ring.waitForWrite(head, WAIT_TIMEOUT_MS);
+    }
+}
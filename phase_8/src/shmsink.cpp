@@ -0,0 +1,39 @@
+#include "shmsink.hpp"
+#include <chrono>
+
+shmsink::shmsink(const std::string &name, uint32_t capacity)
+    : ring(name, capacity)
+{
+}
+
+void shmsink::write(const logmessage &msg)
+{
+    const std::string context = msg.getContext();
+    auto ctx = magic_enum::enum_cast<TelemetrySrc_enum>(context);
+    if (!ctx)
+    {
+        return;
+    }
+    auto severity = magic_enum::enum_cast<SeverityLvl_enum>(msg.getSeverity()).value_or(SeverityLvl_enum::INFO);
+
+    const std::string text = msg.getText();
+    std::string_view label;
+    size_t usage = text.find(" usage:");
+    if (usage != std::string::npos && text.compare(0, context.size(), context) == 0)
+    {
+        label = std::string_view(text).substr(context.size(), usage - context.size());
+        while (!label.empty() && label.front() == ' ')
+        {
+            label.remove_prefix(1);
+        }
+    }
+
+    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::system_clock::now().time_since_epoch()).count();
+    ring.publish(ShmRecord::make(static_cast<uint64_t>(nowMs), *ctx, severity, label, msg.getValue()));
+}
+
+void shmsink::flush()
+{
+    ring.notify();
+}